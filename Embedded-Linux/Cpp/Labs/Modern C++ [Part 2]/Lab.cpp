@@ -2,6 +2,14 @@
 #include <string>
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace MathFunctions
 {
@@ -14,11 +22,107 @@ namespace MathFunctions
 
 namespace StringFunctions
 {
-	void print(std::string s)
+	/*
+	 * ASCII-only case kernels: letters in [lo, hi] get bit 0x20 flipped,
+	 * everything else (including non-ASCII bytes, which are negative as signed
+	 * chars and never fall in the range) is copied unchanged. src and dst may
+	 * be the same buffer.
+	 */
+	inline void flipCase(const char* src, char* dst, size_t n, char lo, char hi)
 	{
-		std::transform(s.begin(), s.end(), s.begin(), ::toupper);
-		std::cout << s << std::endl;
+		size_t i = 0;
+#if defined(__AVX2__)
+		const __m256i lo32 = _mm256_set1_epi8(lo - 1);
+		const __m256i hi32 = _mm256_set1_epi8(hi + 1);
+		const __m256i bit32 = _mm256_set1_epi8(0x20);
+		for (; i + 32 <= n; i += 32)
+		{
+			__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			__m256i m = _mm256_and_si256(_mm256_cmpgt_epi8(v, lo32), _mm256_cmpgt_epi8(hi32, v));
+			v = _mm256_xor_si256(v, _mm256_and_si256(m, bit32));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+		}
+#endif
+#if defined(__SSE2__)
+		const __m128i lo16 = _mm_set1_epi8(lo - 1);
+		const __m128i hi16 = _mm_set1_epi8(hi + 1);
+		const __m128i bit16 = _mm_set1_epi8(0x20);
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			__m128i m = _mm_and_si128(_mm_cmpgt_epi8(v, lo16), _mm_cmplt_epi8(v, hi16));
+			v = _mm_xor_si128(v, _mm_and_si128(m, bit16));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+		}
+#endif
+		for (; i < n; i++)
+		{
+			char c = src[i];
+			dst[i] = (c >= lo && c <= hi) ? static_cast<char>(c ^ 0x20) : c;
+		}
+	}
 
+	inline void to_upper(std::string_view src, char* dst) { flipCase(src.data(), dst, src.size(), 'a', 'z'); }
+	inline void to_lower(std::string_view src, char* dst) { flipCase(src.data(), dst, src.size(), 'A', 'Z'); }
+	inline void to_upper(std::string& s) { flipCase(s.data(), s.data(), s.size(), 'a', 'z'); }
+	inline void to_lower(std::string& s) { flipCase(s.data(), s.data(), s.size(), 'A', 'Z'); }
+
+	inline bool equals_ignore_case(std::string_view a, std::string_view b)
+	{
+		if (a.size() != b.size()) return false;
+		size_t i = 0;
+		const size_t n = a.size();
+#if defined(__SSE2__)
+		const __m128i lo16 = _mm_set1_epi8('A' - 1);
+		const __m128i hi16 = _mm_set1_epi8('Z' + 1);
+		const __m128i bit16 = _mm_set1_epi8(0x20);
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a.data() + i));
+			__m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b.data() + i));
+			x = _mm_or_si128(x, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(x, lo16), _mm_cmplt_epi8(x, hi16)), bit16));
+			y = _mm_or_si128(y, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(y, lo16), _mm_cmplt_epi8(y, hi16)), bit16));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xFFFF) return false;
+		}
+#endif
+		for (; i < n; i++)
+		{
+			char x = a[i], y = b[i];
+			if (x >= 'A' && x <= 'Z') x |= 0x20;
+			if (y >= 'A' && y <= 'Z') y |= 0x20;
+			if (x != y) return false;
+		}
+		return true;
+	}
+
+	void print(std::string_view s)
+	{
+		std::string upper(s.size(), '\0');
+		to_upper(s, upper.data());
+		std::cout << upper << std::endl;
+
+	}
+
+	/* GB/s of the old std::transform(::toupper) path against to_upper. */
+	void benchmark(size_t bytes)
+	{
+		std::vector<char> buf(bytes);
+		for (size_t i = 0; i < bytes; i++)
+		{
+			buf[i] = static_cast<char>(' ' + i % 95);
+		}
+		auto rate = [bytes](auto start, auto end) {
+			return bytes / std::chrono::duration<double>(end - start).count() / 1e9;
+		};
+
+		auto t0 = std::chrono::steady_clock::now();
+		std::transform(buf.begin(), buf.end(), buf.begin(), ::toupper);
+		auto t1 = std::chrono::steady_clock::now();
+		to_upper(std::string_view(buf.data(), bytes), buf.data());
+		auto t2 = std::chrono::steady_clock::now();
+
+		std::cout << "std::transform(::toupper): " << rate(t0, t1) << " GB/s" << std::endl;
+		std::cout << "to_upper:                  " << rate(t1, t2) << " GB/s" << std::endl;
 	}
 }
 
@@ -69,7 +173,13 @@ namespace DynamicAlloc
 	}
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+	{
+		StringFunctions::benchmark(size_t(256) << 20);
+		return 0;
+	}
+
 	double n = 15;
 	std::string s = "mina magdy";
 	int arr[5]{ 1, 2, 3, 4, 5 };
@@ -1,6 +1,16 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <thread>
+#include <algorithm>
+#include <climits>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 
 
 
@@ -17,6 +27,169 @@ std::string HaystackReplace(std::string haystack, const std::string& needle, con
 
 
 
+/*
+ * File-to-file version of HaystackReplace for inputs that do not fit in memory.
+ * The input is mapped one batch at a time (threads * chunkSize bytes plus a
+ * needle-length tail), every chunk is searched on its own thread, and the
+ * output is written with writev straight out of the mapping, so at most one
+ * batch is resident no matter how large the file is.
+ */
+namespace StreamReplace
+{
+    const size_t chunkSize = 4 << 20;
+
+    /* Matches that start inside [chunkStart, chunkEnd), scanning from 'from'. */
+    void FindMatches(std::string_view window, size_t windowBase, size_t from, size_t chunkEnd,
+        const std::string& needle, std::vector<size_t>& matches)
+    {
+        matches.clear();
+        size_t p = window.find(needle, from - windowBase);
+        while (p != std::string_view::npos && windowBase + p < chunkEnd)
+        {
+            matches.push_back(windowBase + p);
+            p = window.find(needle, p + needle.length());
+        }
+    }
+
+    bool WriteAll(int fd, std::vector<iovec>& iov)
+    {
+        size_t i = 0;
+        while (i < iov.size())
+        {
+            int count = static_cast<int>(std::min<size_t>(iov.size() - i, IOV_MAX));
+            ssize_t n = writev(fd, &iov[i], count);
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            /* Skip what was written, trimming a partially written entry. */
+            size_t done = static_cast<size_t>(n);
+            while (i < iov.size() && done >= iov[i].iov_len)
+            {
+                done -= iov[i].iov_len;
+                ++i;
+            }
+            if (done > 0)
+            {
+                iov[i].iov_base = static_cast<char*>(iov[i].iov_base) + done;
+                iov[i].iov_len -= done;
+            }
+        }
+        iov.clear();
+        return true;
+    }
+
+    bool FileReplace(const std::string& inPath, const std::string& outPath,
+        const std::string& needle, const std::string& replacement, unsigned threads)
+    {
+        if (needle.empty())
+        {
+            std::cout << "Needle must not be empty!" << std::endl;
+            return false;
+        }
+        if (threads == 0) threads = 1;
+
+        int in = open(inPath.c_str(), O_RDONLY);
+        if (in < 0)
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return false;
+        }
+        int out = open(outPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (out < 0)
+        {
+            std::cout << "Error opening file!" << std::endl;
+            close(in);
+            return false;
+        }
+
+        struct stat st;
+        fstat(in, &st);
+        const size_t fileSize = static_cast<size_t>(st.st_size);
+        const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        const size_t batchSize = chunkSize * threads;
+
+        std::vector<std::vector<size_t>> matches(threads);
+        std::vector<iovec> iov;
+        /* End of the last replaced match; a match may run into the next chunk. */
+        size_t pos = 0;
+        bool ok = true;
+
+        for (size_t batchStart = 0; ok && batchStart < fileSize; batchStart += batchSize)
+        {
+            size_t batchEnd = std::min(fileSize, batchStart + batchSize);
+            size_t mapStart = batchStart - batchStart % pageSize;
+            size_t mapEnd = std::min(fileSize, batchEnd + needle.length() - 1);
+
+            void* map = mmap(nullptr, mapEnd - mapStart, PROT_READ, MAP_PRIVATE, in, mapStart);
+            if (map == MAP_FAILED)
+            {
+                ok = false;
+                break;
+            }
+            madvise(map, mapEnd - mapStart, MADV_SEQUENTIAL);
+            std::string_view window(static_cast<const char*>(map), mapEnd - mapStart);
+
+            size_t chunks = (batchEnd - batchStart + chunkSize - 1) / chunkSize;
+            std::vector<std::thread> workers;
+            for (size_t c = 0; c < chunks; c++)
+            {
+                size_t chunkStart = batchStart + c * chunkSize;
+                size_t chunkEnd = std::min(batchEnd, chunkStart + chunkSize);
+                workers.emplace_back(FindMatches, window, mapStart, chunkStart, chunkEnd,
+                    std::cref(needle), std::ref(matches[c]));
+            }
+            for (auto& t : workers)
+            {
+                t.join();
+            }
+
+            for (size_t c = 0; c < chunks; c++)
+            {
+                size_t chunkStart = batchStart + c * chunkSize;
+                size_t chunkEnd = std::min(batchEnd, chunkStart + chunkSize);
+                /* The previous chunk's last match overlapped this one: rescan from its end. */
+                if (pos > chunkStart && pos < chunkEnd)
+                {
+                    FindMatches(window, mapStart, pos, chunkEnd, needle, matches[c]);
+                }
+                for (size_t m : matches[c])
+                {
+                    if (m < pos) continue;
+                    if (m > pos)
+                    {
+                        iov.push_back({ const_cast<char*>(window.data() + (pos - mapStart)), m - pos });
+                    }
+                    if (!replacement.empty())
+                    {
+                        iov.push_back({ const_cast<char*>(replacement.data()), replacement.length() });
+                    }
+                    pos = m + needle.length();
+                }
+            }
+            if (pos < batchEnd)
+            {
+                iov.push_back({ const_cast<char*>(window.data() + (pos - mapStart)), batchEnd - pos });
+                pos = batchEnd;
+            }
+
+            ok = WriteAll(out, iov);
+            munmap(map, mapEnd - mapStart);
+        }
+
+        if (!ok)
+        {
+            std::cout << "Error replacing file!" << std::endl;
+        }
+        close(in);
+        close(out);
+        return ok;
+    }
+}
+
+
+
 
 
 
@@ -64,8 +237,15 @@ std::vector<std::vector<int>> Transpose(const std::vector<std::vector<int>>& mat
 
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    /* Labs <input> <output> <needle> <replacement> [threads] */
+    if (argc >= 5)
+    {
+        unsigned threads = argc > 5 ? std::stoul(argv[5]) : std::thread::hardware_concurrency();
+        return StreamReplace::FileReplace(argv[1], argv[2], argv[3], argv[4], threads) ? 0 : 1;
+    }
+
     
     std::string s = "The cycle of life is a cycle of cycles";
     std::string S_Replace = "cycle";
@@ -1,44 +1,258 @@
 #include <iostream>
-#include <cstdlib>
+#include <iomanip>
 #include <ctime>
 #include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <exception>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <chrono>
 
 
+/*
+ * xoshiro256** generator. Each simulation thread owns one, so there is no
+ * shared state as with std::rand(), and a run is reproducible from its seed:
+ * thread t uses the seed's stream advanced by t jumps of 2^128 draws.
+ */
+class Xoshiro256
+{
+private:
+	uint64_t s[4];
+
+	static uint64_t rotl(uint64_t x, int k)
+	{
+		return (x << k) | (x >> (64 - k));
+	}
+
+public:
+	explicit Xoshiro256(uint64_t seed)
+	{
+		/* splitmix64 spreads the seed over the whole state. */
+		for (auto& word : s)
+		{
+			seed += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			word = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t next()
+	{
+		const uint64_t result = rotl(s[1] * 5, 7) * 9;
+		const uint64_t t = s[1] << 17;
+		s[2] ^= s[0];
+		s[3] ^= s[1];
+		s[1] ^= s[2];
+		s[0] ^= s[3];
+		s[2] ^= t;
+		s[3] = rotl(s[3], 45);
+		return result;
+	}
+
+	/* Equivalent to 2^128 calls to next(). */
+	void jump()
+	{
+		static const uint64_t table[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+		uint64_t t[4] = { 0, 0, 0, 0 };
+		for (uint64_t word : table)
+		{
+			for (int b = 0; b < 64; b++)
+			{
+				if (word & (uint64_t(1) << b))
+				{
+					for (int i = 0; i < 4; i++) t[i] ^= s[i];
+				}
+				next();
+			}
+		}
+		std::memcpy(s, t, sizeof(s));
+	}
+
+	/* Unbiased value in [0, n) (Lemire's multiply-and-reject). */
+	uint32_t below(uint32_t n)
+	{
+		uint64_t m = static_cast<uint64_t>(next() >> 32) * n;
+		uint32_t low = static_cast<uint32_t>(m);
+		if (low < n)
+		{
+			uint32_t threshold = static_cast<uint32_t>(-n) % n;
+			while (low < threshold)
+			{
+				m = static_cast<uint64_t>(next() >> 32) * n;
+				low = static_cast<uint32_t>(m);
+			}
+		}
+		return static_cast<uint32_t>(m >> 32);
+	}
+};
+
+
+/*
+ * Board state is kept as bitboards: one bit per cell, each row stored as a
+ * band of 64-bit words in a single contiguous array, for boards up to
+ * maxSide x maxSide. A guess touches one word of each board, and the hit and
+ * remaining counts are kept as counters or recomputed with popcount over the
+ * words a row or ship spans.
+ */
 class Battleship
 {
+public:
+	struct Ship
+	{
+		int row;
+		int col;
+		int length;
+		bool horizontal;
+	};
+
 private:
-	std::vector<std::vector<bool>> board;
+	int rows;
+	int cols;
+	int wordsPerRow;
+	std::vector<uint64_t> ships;
+	std::vector<uint64_t> shots;
+	std::vector<Ship> fleet;
+	long long shipCells;
+	long long hits;
 	int guesses;
 	int maxGuesses;
-	int locationX;
-	int locationY;
+
+	size_t wordIndex(int x, int y) const
+	{
+		return static_cast<size_t>(x) * wordsPerRow + (y >> 6);
+	}
+
+	static uint64_t bitMask(int y)
+	{
+		return uint64_t(1) << (y & 63);
+	}
+
+	/* Bits [from, to] of a row that fall into word w of that row. */
+	static uint64_t spanMask(int w, int from, int to)
+	{
+		int lo = std::max(from, w * 64) - w * 64;
+		int hi = std::min(to, w * 64 + 63) - w * 64;
+		uint64_t upper = (hi == 63) ? ~uint64_t(0) : ((uint64_t(1) << (hi + 1)) - 1);
+		return upper & ~((uint64_t(1) << lo) - 1);
+	}
+
+	/* Calls f(wordIndex, mask) for every board word the ship covers. */
+	template <typename F>
+	void forEachWord(const Ship& ship, F f) const
+	{
+		if (ship.horizontal)
+		{
+			int last = ship.col + ship.length - 1;
+			for (int w = ship.col >> 6; w <= last >> 6; w++)
+			{
+				f(static_cast<size_t>(ship.row) * wordsPerRow + w, spanMask(w, ship.col, last));
+			}
+		}
+		else
+		{
+			for (int x = ship.row; x < ship.row + ship.length; x++)
+			{
+				f(wordIndex(x, ship.col), bitMask(ship.col));
+			}
+		}
+	}
+
+	bool place(const Ship& ship)
+	{
+		bool free = true;
+		forEachWord(ship, [&](size_t w, uint64_t mask) { free = free && !(ships[w] & mask); });
+		if (!free) return false;
+		forEachWord(ship, [&](size_t w, uint64_t mask) { ships[w] |= mask; });
+		fleet.push_back(ship);
+		shipCells += ship.length;
+		return true;
+	}
+
 public:
-	Battleship(int maxGuesses) : guesses(0), maxGuesses(maxGuesses)
+	static const int maxSide = 4096;
+
+	Battleship(int maxGuesses) : Battleship(5, 5, { 1 }, maxGuesses)
 	{
-		board = std::vector<std::vector<bool>>(5, std::vector<bool>(5, false));
+	}
 
-		std::srand(std::time(0));
-		locationX = std::rand() % 5;
-		locationY = std::rand() % 5;
-		board[locationX][locationY] = true;
+	Battleship(int rows, int cols, const std::vector<int>& shipLengths, int maxGuesses)
+		: Battleship(rows, cols, shipLengths, maxGuesses, Xoshiro256(std::time(0)))
+	{
 	}
 
-	bool guess(int x, int y)
+	Battleship(int rows, int cols, const std::vector<int>& shipLengths, int maxGuesses, Xoshiro256&& rng)
+		: Battleship(rows, cols, shipLengths, maxGuesses, rng)
+	{
+	}
+
+	/* Ships are placed with the caller's generator, so a seeded game is reproducible. */
+	Battleship(int rows, int cols, const std::vector<int>& shipLengths, int maxGuesses, Xoshiro256& rng)
+		: rows(rows), cols(cols), wordsPerRow((cols + 63) / 64), shipCells(0), hits(0), guesses(0), maxGuesses(maxGuesses)
+	{
+		if (rows < 1 || cols < 1 || rows > maxSide || cols > maxSide)
+		{
+			throw std::invalid_argument("board size must be between 1 and 4096");
+		}
+		ships.assign(static_cast<size_t>(rows) * wordsPerRow, 0);
+		shots.assign(ships.size(), 0);
+
+		for (int length : shipLengths)
+		{
+			if (length < 1 || (length > rows && length > cols))
+			{
+				throw std::invalid_argument("ship does not fit on the board");
+			}
+			Ship ship;
+			int attempts = 0;
+			do
+			{
+				if (++attempts > 100000)
+				{
+					throw std::invalid_argument("ships do not fit on the board");
+				}
+				ship.length = length;
+				ship.horizontal = (length > rows) || (length <= cols && rng.below(2) == 0);
+				ship.row = rng.below(ship.horizontal ? rows : rows - length + 1);
+				ship.col = rng.below(ship.horizontal ? cols - length + 1 : cols);
+			} while (!place(ship));
+		}
+	}
+
+	/* Records a shot without any output; true if it hit a ship. */
+	bool fire(int x, int y)
 	{
-		bool status = false;
 		++guesses;
-		if (board[x][y])
+		size_t w = wordIndex(x, y);
+		uint64_t bit = bitMask(y);
+		bool hit = (ships[w] & bit) != 0;
+		if (hit && !(shots[w] & bit))
 		{
-			status = true;
+			++hits;
 		}
-		else
+		shots[w] |= bit;
+		return hit;
+	}
+
+	bool guess(int x, int y)
+	{
+		bool status = fire(x, y);
+		if (!status)
 		{
 			std::cout << "You miss the spot!... :(\n";
-			if (x == locationX)
+			if (remainingInRow(x) > 0)
 			{
 				std::cout << "You are on the right X-axis as the Battleship!..\n";
 			}
-			else if (y == locationY)
+			else if (remainingInColumn(y) > 0)
 			{
 				std::cout << "You are on the right Y-axis as the Battleship!..\n";
 			}
@@ -46,6 +260,90 @@ public:
 		return status;
 	}
 
+	/* Ship cells in row x that have not been hit yet. */
+	int remainingInRow(int x) const
+	{
+		int count = 0;
+		for (size_t w = wordIndex(x, 0); w < wordIndex(x, 0) + wordsPerRow; w++)
+		{
+			count += __builtin_popcountll(ships[w] & ~shots[w]);
+		}
+		return count;
+	}
+
+	/* Ship cells in column y that have not been hit yet. */
+	int remainingInColumn(int y) const
+	{
+		int count = 0;
+		for (const Ship& ship : fleet)
+		{
+			if (ship.horizontal && y >= ship.col && y < ship.col + ship.length)
+			{
+				/* Only one word of the row holds column y */
+				count += !(shots[wordIndex(ship.row, y)] & bitMask(y));
+			}
+			else if (!ship.horizontal && y == ship.col)
+			{
+				forEachWord(ship, [&](size_t w, uint64_t mask) { count += __builtin_popcountll(mask & ~shots[w]); });
+			}
+		}
+		return count;
+	}
+
+	/* Cells of ship i that have not been hit yet. */
+	int remainingOfShip(size_t i) const
+	{
+		int count = 0;
+		forEachWord(fleet[i], [&](size_t w, uint64_t mask) { count += __builtin_popcountll(mask & ~shots[w]); });
+		return count;
+	}
+
+	bool isSunk(size_t i) const
+	{
+		return remainingOfShip(i) == 0;
+	}
+
+	/* Index of the ship covering (x, y), or -1. */
+	int shipAt(int x, int y) const
+	{
+		if (!(ships[wordIndex(x, y)] & bitMask(y))) return -1;
+		for (size_t i = 0; i < fleet.size(); i++)
+		{
+			const Ship& ship = fleet[i];
+			if (ship.horizontal ? (x == ship.row && y >= ship.col && y < ship.col + ship.length)
+				: (y == ship.col && x >= ship.row && x < ship.row + ship.length))
+			{
+				return static_cast<int>(i);
+			}
+		}
+		return -1;
+	}
+
+	const Ship& getShip(size_t i) const
+	{
+		return fleet[i];
+	}
+
+	size_t shipCount() const
+	{
+		return fleet.size();
+	}
+
+	long long getHits() const
+	{
+		return hits;
+	}
+
+	long long remainingCells() const
+	{
+		return shipCells - hits;
+	}
+
+	bool allSunk() const
+	{
+		return hits == shipCells;
+	}
+
 	bool gameOver() const
 	{
 		return (maxGuesses == guesses);
@@ -56,6 +354,16 @@ public:
 		return guesses;
 	}
 
+	int getRows() const
+	{
+		return rows;
+	}
+
+	int getCols() const
+	{
+		return cols;
+	}
+
 	~Battleship()
 	{
 	}
@@ -69,8 +377,375 @@ public:
 
 
 
-int main()
+/*
+ * A guessing strategy for the simulator. It is told the board size and fleet
+ * at the start of a game, asked for the next cell, and told the result; when
+ * a shot sinks a ship the ship itself is revealed, as in the table-top game.
+ */
+class Strategy
 {
+protected:
+	enum Cell : uint8_t { Unknown, Miss, Hit, Sunk };
+
+	int rows = 0;
+	int cols = 0;
+	std::vector<uint8_t> cells;
+	std::vector<int> remainingLengths;
+
+public:
+	virtual ~Strategy()
+	{
+	}
+
+	virtual void reset(int rows, int cols, const std::vector<int>& shipLengths)
+	{
+		this->rows = rows;
+		this->cols = cols;
+		cells.assign(static_cast<size_t>(rows) * cols, Unknown);
+		remainingLengths = shipLengths;
+	}
+
+	virtual int next(Xoshiro256& rng) = 0;
+
+	virtual void update(int cell, bool hit, const Battleship::Ship* sunk)
+	{
+		cells[cell] = hit ? Hit : Miss;
+		if (sunk)
+		{
+			for (int k = 0; k < sunk->length; k++)
+			{
+				int x = sunk->row + (sunk->horizontal ? 0 : k);
+				int y = sunk->col + (sunk->horizontal ? k : 0);
+				cells[x * cols + y] = Sunk;
+			}
+			auto it = std::find(remainingLengths.begin(), remainingLengths.end(), sunk->length);
+			if (it != remainingLengths.end()) remainingLengths.erase(it);
+		}
+	}
+};
+
+/* Uniformly random among the cells not shot yet. */
+class RandomStrategy : public Strategy
+{
+protected:
+	std::vector<int> open;
+	std::vector<int> position;
+
+	void remove(int cell)
+	{
+		int p = position[cell];
+		if (p < 0) return;
+		open[p] = open.back();
+		position[open[p]] = p;
+		open.pop_back();
+		position[cell] = -1;
+	}
+
+public:
+	void reset(int rows, int cols, const std::vector<int>& shipLengths) override
+	{
+		Strategy::reset(rows, cols, shipLengths);
+		open.resize(cells.size());
+		position.resize(cells.size());
+		for (size_t i = 0; i < cells.size(); i++)
+		{
+			open[i] = static_cast<int>(i);
+			position[i] = static_cast<int>(i);
+		}
+	}
+
+	int next(Xoshiro256& rng) override
+	{
+		return open[rng.below(static_cast<uint32_t>(open.size()))];
+	}
+
+	void update(int cell, bool hit, const Battleship::Ship* sunk) override
+	{
+		Strategy::update(cell, hit, sunk);
+		remove(cell);
+	}
+};
+
+/* Random until a hit, then works through the hit's neighbours. */
+class HuntTargetStrategy : public RandomStrategy
+{
+private:
+	std::vector<int> targets;
+
+public:
+	void reset(int rows, int cols, const std::vector<int>& shipLengths) override
+	{
+		RandomStrategy::reset(rows, cols, shipLengths);
+		targets.clear();
+	}
+
+	int next(Xoshiro256& rng) override
+	{
+		while (!targets.empty())
+		{
+			int cell = targets.back();
+			if (cells[cell] == Unknown) return cell;
+			targets.pop_back();
+		}
+		return RandomStrategy::next(rng);
+	}
+
+	void update(int cell, bool hit, const Battleship::Ship* sunk) override
+	{
+		RandomStrategy::update(cell, hit, sunk);
+		if (hit && !sunk)
+		{
+			int x = cell / cols;
+			int y = cell % cols;
+			if (x > 0) targets.push_back(cell - cols);
+			if (x + 1 < rows) targets.push_back(cell + cols);
+			if (y > 0) targets.push_back(cell - 1);
+			if (y + 1 < cols) targets.push_back(cell + 1);
+		}
+	}
+};
+
+/*
+ * Probability-density hunter: every placement of every ship still afloat that
+ * avoids known misses and sunk ships adds weight to the cells it covers, with
+ * placements through unresolved hits weighted far higher. The open cell with
+ * the most weight is shot next.
+ */
+class DensityStrategy : public Strategy
+{
+private:
+	std::vector<long long> density;
+
+	void addPlacements(int length, bool horizontal)
+	{
+		int maxRow = horizontal ? rows : rows - length + 1;
+		int maxCol = horizontal ? cols - length + 1 : cols;
+		int step = horizontal ? 1 : cols;
+		for (int x = 0; x < maxRow; x++)
+		{
+			for (int y = 0; y < maxCol; y++)
+			{
+				int first = x * cols + y;
+				int hits = 0;
+				bool valid = true;
+				for (int k = 0; k < length && valid; k++)
+				{
+					uint8_t c = cells[first + k * step];
+					valid = (c == Unknown || c == Hit);
+					hits += (c == Hit);
+				}
+				if (!valid) continue;
+				long long weight = 1 + 1000LL * hits;
+				for (int k = 0; k < length; k++)
+				{
+					density[first + k * step] += weight;
+				}
+			}
+		}
+	}
+
+public:
+	int next(Xoshiro256& rng) override
+	{
+		density.assign(cells.size(), 0);
+		for (int length : remainingLengths)
+		{
+			addPlacements(length, true);
+			if (length > 1) addPlacements(length, false);
+		}
+
+		int best = -1;
+		int ties = 0;
+		for (size_t i = 0; i < cells.size(); i++)
+		{
+			if (cells[i] != Unknown) continue;
+			if (best < 0 || density[i] > density[best])
+			{
+				best = static_cast<int>(i);
+				ties = 1;
+			}
+			else if (density[i] == density[best] && rng.below(++ties) == 0)
+			{
+				best = static_cast<int>(i);
+			}
+		}
+		return best;
+	}
+};
+
+std::unique_ptr<Strategy> makeStrategy(const std::string& name)
+{
+	if (name == "random") return std::make_unique<RandomStrategy>();
+	if (name == "hunt") return std::make_unique<HuntTargetStrategy>();
+	if (name == "density") return std::make_unique<DensityStrategy>();
+	return nullptr;
+}
+
+/* Plays one game to the end and returns the number of shots it took. */
+int playGame(int rows, int cols, const std::vector<int>& shipLengths, Strategy& strategy, Xoshiro256& rng)
+{
+	Battleship game(rows, cols, shipLengths, rows * cols, rng);
+	strategy.reset(rows, cols, shipLengths);
+	while (!game.allSunk())
+	{
+		int cell = strategy.next(rng);
+		int x = cell / cols;
+		int y = cell % cols;
+		bool hit = game.fire(x, y);
+		const Battleship::Ship* sunk = nullptr;
+		if (hit)
+		{
+			int ship = game.shipAt(x, y);
+			if (game.isSunk(ship)) sunk = &game.getShip(ship);
+		}
+		strategy.update(cell, hit, sunk);
+	}
+	return game.getGuesses();
+}
+
+/*
+ * Plays games on every thread, each with its own strategy instance and
+ * generator stream, and prints throughput and the shots-per-game distribution.
+ */
+void simulate(const std::string& strategyName, int rows, int cols, const std::vector<int>& shipLengths,
+	long long games, unsigned threads, uint64_t seed)
+{
+	/* One game here throws for a bad board or fleet before any thread starts */
+	Battleship check(rows, cols, shipLengths, 1, Xoshiro256(seed));
+	std::vector<std::vector<long long>> histograms(threads, std::vector<long long>(static_cast<size_t>(rows) * cols + 1, 0));
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> workers;
+	std::vector<std::exception_ptr> failures(threads);
+	for (unsigned t = 0; t < threads; t++)
+	{
+		workers.emplace_back([&, t]() {
+			try
+			{
+				Xoshiro256 rng(seed);
+				for (unsigned j = 0; j < t; j++) rng.jump();
+				std::unique_ptr<Strategy> strategy = makeStrategy(strategyName);
+				long long share = games / threads + (t < games % threads ? 1 : 0);
+				for (long long g = 0; g < share; g++)
+				{
+					histograms[t][playGame(rows, cols, shipLengths, *strategy, rng)]++;
+				}
+			}
+			catch (...)
+			{
+				/* A crowded fleet can still fail to place in a later game */
+				failures[t] = std::current_exception();
+			}
+		});
+	}
+	for (auto& w : workers)
+	{
+		w.join();
+	}
+	for (auto& failure : failures)
+	{
+		if (failure) std::rethrow_exception(failure);
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::vector<long long> histogram(histograms[0].size(), 0);
+	for (auto& h : histograms)
+	{
+		for (size_t i = 0; i < h.size(); i++) histogram[i] += h[i];
+	}
+
+	auto percentile = [&](double q) {
+		long long rank = std::max<long long>(1, static_cast<long long>(q * games + 0.999999));
+		long long seen = 0;
+		for (size_t i = 0; i < histogram.size(); i++)
+		{
+			seen += histogram[i];
+			if (seen >= rank) return static_cast<int>(i);
+		}
+		return static_cast<int>(histogram.size() - 1);
+	};
+	double mean = 0;
+	for (size_t i = 0; i < histogram.size(); i++) mean += static_cast<double>(i) * histogram[i];
+	mean /= games;
+
+	std::cout << "Strategy: " << strategyName << ", board " << rows << "x" << cols << ", " << shipLengths.size() << " ships\n";
+	std::cout << games << " games in " << std::fixed << std::setprecision(3) << seconds << " s on " << threads
+		<< " threads (" << std::setprecision(0) << games / seconds << " games/s)\n";
+	std::cout << std::setprecision(2) << "Shots per game: mean " << mean << ", min " << percentile(0)
+		<< ", p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99)
+		<< ", max " << percentile(1.0) << "\n";
+
+	/* Distribution in ten-shot buckets, bars scaled to the largest bucket. */
+	const int width = 10;
+	std::vector<long long> buckets(histogram.size() / width + 1, 0);
+	for (size_t i = 0; i < histogram.size(); i++) buckets[i / width] += histogram[i];
+	long long largest = *std::max_element(buckets.begin(), buckets.end());
+	for (size_t b = 0; b < buckets.size(); b++)
+	{
+		if (buckets[b] == 0) continue;
+		std::cout << std::setw(5) << b * width << "-" << std::left << std::setw(5) << b * width + width - 1 << std::right
+			<< std::setw(7) << std::setprecision(2) << 100.0 * buckets[b] / games << "% "
+			<< std::string(static_cast<size_t>(50 * buckets[b] / largest), '#') << "\n";
+	}
+}
+
+/* "5,4,3" -> { 5, 4, 3 } */
+std::vector<int> parseLengths(const std::string& text)
+{
+	std::vector<int> lengths;
+	std::stringstream in(text);
+	std::string item;
+	while (std::getline(in, item, ','))
+	{
+		lengths.push_back(std::stoi(item));
+	}
+	return lengths;
+}
+
+/*
+ * Lab                  interactive 5x5 game
+ * Lab --simulate [--strategy random|hunt|density] [--games N] [--threads N]
+ *     [--seed S] [--board ROWSxCOLS] [--ships 5,4,3,3,2]
+ */
+int main(int argc, char* argv[])
+{
+	if (argc > 1 && std::strcmp(argv[1], "--simulate") == 0)
+	{
+		std::string strategy = "density";
+		long long games = 100000;
+		unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+		uint64_t seed = 1;
+		int rows = 10;
+		int cols = 10;
+		std::vector<int> shipLengths = { 5, 4, 3, 3, 2 };
+		for (int i = 2; i + 1 < argc; i += 2)
+		{
+			std::string option = argv[i];
+			std::string value = argv[i + 1];
+			if (option == "--strategy") strategy = value;
+			else if (option == "--games") games = std::stoll(value);
+			else if (option == "--threads") threads = std::max(1, std::stoi(value));
+			else if (option == "--seed") seed = std::stoull(value);
+			else if (option == "--board") std::sscanf(value.c_str(), "%dx%d", &rows, &cols);
+			else if (option == "--ships") shipLengths = parseLengths(value);
+		}
+		if (!makeStrategy(strategy) || games < 1)
+		{
+			std::cout << "Unknown strategy or game count!\n";
+			return 1;
+		}
+		try
+		{
+			simulate(strategy, rows, cols, shipLengths, games, threads, seed);
+		}
+		catch (const std::invalid_argument& e)
+		{
+			std::cout << e.what() << "\n";
+			return 1;
+		}
+		return 0;
+	}
+
 	const int maxGuesses = 5;
 	Battleship game(maxGuesses);
 	int x, y;
@@ -90,9 +765,13 @@ int main()
 			if (game.guess(x - 1, y - 1))
 			{
 				std::cout << "You hit the battleship!\n";
-				std::cout << "You won in " << game.getGuesses() << " guesses!\n";
-				WonFlag = true;
-				break;
+				if (game.allSunk())
+				{
+					std::cout << "You won in " << game.getGuesses() << " guesses!\n";
+					WonFlag = true;
+					break;
+				}
+				std::cout << "You have " << (maxGuesses - game.getGuesses()) << " guesses left.\n";
 			}
 			else
 			{
@@ -3,63 +3,1208 @@
 #include <vector>
 #include <iomanip>
 #include <limits>
+#include <sstream>
+#include <cmath>
+#include <string>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include <cstdio>
+#include <thread>
+#include <chrono>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-int main() {
-    std::ifstream inputFile("input.txt");
-    std::ofstream outputFile("output.txt");
 
-    if (!inputFile.is_open() || !outputFile.is_open()) 
-	{
-        std::cout << "Error opening file!" << std::endl;
-        return 1;
+/* Read-only mapping of a whole input file. */
+class MappedFile
+{
+private:
+    int fd;
+    const char* bytes;
+    size_t length;
+public:
+    explicit MappedFile(const char* path) : fd(open(path, O_RDONLY)), bytes(nullptr), length(0)
+    {
+        struct stat st;
+        if (fd < 0 || fstat(fd, &st) < 0 || st.st_size == 0)
+        {
+            return;
+        }
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map != MAP_FAILED)
+        {
+            madvise(map, st.st_size, MADV_SEQUENTIAL);
+            bytes = static_cast<const char*>(map);
+            length = st.st_size;
+        }
     }
 
-    std::vector<int> numbers;
-    int number;
-    while (inputFile >> number) 
-	{
-        numbers.push_back(number);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return fd >= 0; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    ~MappedFile()
+    {
+        if (bytes) munmap(const_cast<char*>(bytes), length);
+        if (fd >= 0) close(fd);
     }
+};
 
-    if (numbers.empty()) 
-	{
-        std::cout << "No data in input file!" << std::endl;
-        return 1;
+
+struct ParseError
+{
+    size_t offset;
+    std::string token;
+};
+
+/* Any byte <= ' ' (space, tab, CR, LF, ...) separates two tokens. */
+inline bool isSeparator(char c)
+{
+    return static_cast<unsigned char>(c) <= ' ';
+}
+
+/* Length of the token starting at p, scanning 16 bytes per step with SSE2. */
+inline size_t tokenLength(const char* p, const char* end)
+{
+    const char* q = p;
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi8(' ');
+    while (q + 16 <= end)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q));
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(v, space), v));
+        if (mask)
+        {
+            return (q - p) + __builtin_ctz(mask);
+        }
+        q += 16;
+    }
+#endif
+    while (q < end && !isSeparator(*q)) q++;
+    return q - p;
+}
+
+/*
+ * Calls sink(value) for every integer in [begin, end). Tokens that are not a
+ * valid integer, or do not fit in T, are recorded with their byte offset
+ * (relative to baseOffset) and skipped.
+ */
+template <typename T, typename Sink>
+void parseIntegers(const char* begin, const char* end, size_t baseOffset, Sink&& sink, std::vector<ParseError>& errors)
+{
+    const char* p = begin;
+    while (true)
+    {
+        while (p < end && isSeparator(*p)) p++;
+        if (p == end) break;
+
+        const char* tokEnd = p + tokenLength(p, end);
+        const char* digits = (*p == '+' && p + 1 < tokEnd && p[1] != '-') ? p + 1 : p;
+        T value;
+        auto result = std::from_chars(digits, tokEnd, value);
+        if (result.ec == std::errc() && result.ptr == tokEnd)
+        {
+            sink(value);
+        }
+        else
+        {
+            errors.push_back({ baseOffset + (p - begin), std::string(p, tokEnd) });
+        }
+        p = tokEnd;
+    }
+}
+
+void reportErrors(const char* source, const std::vector<ParseError>& errors)
+{
+    const size_t maxShown = 10;
+    for (size_t i = 0; i < errors.size() && i < maxShown; i++)
+    {
+        std::cout << source << ": malformed token at offset " << errors[i].offset << ": \"" << errors[i].token << "\"" << std::endl;
+    }
+    if (errors.size() > maxShown)
+    {
+        std::cout << source << ": ... " << errors.size() - maxShown << " more malformed tokens" << std::endl;
+    }
+}
+
+
+/*
+ * O(1)-memory running statistics. The sum is kept in 128 bits so it cannot
+ * overflow for any realistic count of int64 values, and the variance uses
+ * Welford's update. Two partial results combine with merge() (Chan et al.),
+ * so independent sources can be reduced separately and joined at the end.
+ */
+struct Stats
+{
+    uint64_t count = 0;
+    __int128 sum = 0;
+    int64_t min = std::numeric_limits<int64_t>::max();
+    int64_t max = std::numeric_limits<int64_t>::min();
+    double mean = 0;
+    double m2 = 0;
+
+    void add(int64_t x)
+    {
+        ++count;
+        sum += x;
+        if (x < min) min = x;
+        if (x > max) max = x;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    void merge(const Stats& other)
+    {
+        if (other.count == 0) return;
+        if (count == 0)
+        {
+            *this = other;
+            return;
+        }
+        double n = static_cast<double>(count) + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / n;
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / n);
+        count += other.count;
+        sum += other.sum;
+        min = std::min(min, other.min);
+        max = std::max(max, other.max);
+    }
+
+    /*
+     * Reduces a whole block at once: min/max/sum run four int64 lanes wide
+     * with AVX2, the block's M2 is computed around its own mean, and the
+     * result is merged like any other partial.
+     */
+    void addBlock(const int64_t* values, size_t n)
+    {
+        if (n == 0) return;
+        Stats block;
+        block.count = n;
+
+        size_t i = 0;
+        int64_t lo = values[0];
+        int64_t hi = values[0];
+#if defined(__AVX2__)
+        if (n >= 4)
+        {
+            __m256i vmin = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+            __m256i vmax = vmin;
+            for (i = 4; i + 4 <= n; i += 4)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i));
+                vmin = _mm256_blendv_epi8(vmin, v, _mm256_cmpgt_epi64(vmin, v));
+                vmax = _mm256_blendv_epi8(vmax, v, _mm256_cmpgt_epi64(v, vmax));
+            }
+            alignas(32) int64_t mins[4], maxs[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(mins), vmin);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(maxs), vmax);
+            lo = *std::min_element(mins, mins + 4);
+            hi = *std::max_element(maxs, maxs + 4);
+        }
+#endif
+        for (; i < n; i++)
+        {
+            lo = std::min(lo, values[i]);
+            hi = std::max(hi, values[i]);
+        }
+        block.min = lo;
+        block.max = hi;
+
+        /* With every value in int32 range, int64 lanes cannot overflow for blockSize values. */
+        if (lo >= std::numeric_limits<int32_t>::min() && hi <= std::numeric_limits<int32_t>::max() && n <= blockSize)
+        {
+            int64_t s = 0;
+            i = 0;
+#if defined(__AVX2__)
+            __m256i vsum = _mm256_setzero_si256();
+            for (; i + 4 <= n; i += 4)
+            {
+                vsum = _mm256_add_epi64(vsum, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+            }
+            alignas(32) int64_t sums[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(sums), vsum);
+            s = sums[0] + sums[1] + sums[2] + sums[3];
+#endif
+            for (; i < n; i++) s += values[i];
+            block.sum = s;
+        }
+        else
+        {
+            for (i = 0; i < n; i++) block.sum += values[i];
+        }
+
+        block.mean = static_cast<double>(static_cast<long double>(block.sum) / n);
+        double m2[4] = { 0, 0, 0, 0 };
+        for (i = 0; i + 4 <= n; i += 4)
+        {
+            for (int k = 0; k < 4; k++)
+            {
+                double d = values[i + k] - block.mean;
+                m2[k] += d * d;
+            }
+        }
+        for (; i < n; i++)
+        {
+            double d = values[i] - block.mean;
+            m2[0] += d * d;
+        }
+        block.m2 = (m2[0] + m2[1]) + (m2[2] + m2[3]);
+
+        merge(block);
+    }
+
+    static const size_t blockSize = 1024;
+
+    double average() const
+    {
+        return count ? static_cast<double>(static_cast<long double>(sum) / count) : 0;
+    }
+
+    /* Sample variance. */
+    double variance() const
+    {
+        return count > 1 ? m2 / (count - 1) : 0;
+    }
+};
+
+/*
+ * Log-linear (HDR style) histogram over int64 used for quantiles. Magnitudes
+ * below 2^subBits get one bucket each; above that every power of two is split
+ * into 2^subBits buckets, so a reported quantile is within 2^-subBits (0.8%)
+ * of the true value while memory stays fixed at ~116 KB. Negative values use
+ * a mirrored set of buckets below the positive ones, keeping the bucket index
+ * monotone in the value. Histograms merge by adding counts.
+ */
+class Histogram
+{
+private:
+    static const int subBits = 7;
+    static const size_t subCount = size_t(1) << subBits;
+    static const size_t perSign = (65 - subBits) * subCount;
+
+    std::vector<uint64_t> counts;
+
+    static size_t magnitudeIndex(uint64_t m)
+    {
+        if (m < subCount) return m;
+        int e = 63 - __builtin_clzll(m);
+        return (size_t(e - subBits + 1) << subBits) + (m >> (e - subBits)) - subCount;
+    }
+
+    /* Midpoint of the magnitudes that share bucket idx. */
+    static uint64_t magnitudeValue(size_t idx)
+    {
+        if (idx < subCount) return idx;
+        int shift = static_cast<int>(idx >> subBits) - 1;
+        uint64_t low = ((idx & (subCount - 1)) + subCount) << shift;
+        return low + ((uint64_t(1) << shift) >> 1);
+    }
+
+public:
+    Histogram() : counts(2 * perSign, 0) {}
+
+    void add(int64_t x)
+    {
+        if (x < 0)
+        {
+            counts[perSign - 1 - magnitudeIndex(-static_cast<uint64_t>(x))]++;
+        }
+        else
+        {
+            counts[perSign + magnitudeIndex(x)]++;
+        }
     }
 
-    int sum = 0;
-    int min = 0x7FFFFFFF;
-    int max = 0x80000000;
+    void addBlock(const int64_t* values, size_t n)
+    {
+        for (size_t i = 0; i < n; i++) add(values[i]);
+    }
+
+    void merge(const Histogram& other)
+    {
+        for (size_t i = 0; i < counts.size(); i++) counts[i] += other.counts[i];
+    }
+
+    void save(std::ostream& out) const
+    {
+        out.write(reinterpret_cast<const char*>(counts.data()), counts.size() * sizeof(uint64_t));
+    }
+
+    bool load(std::istream& in)
+    {
+        in.read(reinterpret_cast<char*>(counts.data()), counts.size() * sizeof(uint64_t));
+        return static_cast<bool>(in);
+    }
 
-    for (int num : numbers) {
-        sum += num;
-        if (num < min) min = num;
-        if (num > max) max = num;
+    /* Value at quantile q in [0, 1], clamped to the exact [min, max] of the data. */
+    int64_t quantile(double q, uint64_t total, int64_t min, int64_t max) const
+    {
+        if (total == 0) return 0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * total)));
+        uint64_t seen = 0;
+        size_t idx = 0;
+        for (; idx < counts.size(); idx++)
+        {
+            seen += counts[idx];
+            if (seen >= rank) break;
+        }
+        int64_t value = idx < perSign
+            ? -static_cast<int64_t>(magnitudeValue(perSign - 1 - idx))
+            : static_cast<int64_t>(magnitudeValue(idx - perSign));
+        return std::clamp(value, min, max);
     }
+};
+
+/* Everything one source, thread or run reduces to. */
+struct Summary
+{
+    Stats stats;
+    Histogram histogram;
+
+    void merge(const Summary& other)
+    {
+        stats.merge(other.stats);
+        histogram.merge(other.histogram);
+    }
+
+    void save(std::ostream& out) const
+    {
+        out.write(reinterpret_cast<const char*>(&stats), sizeof(stats));
+        histogram.save(out);
+    }
+
+    bool load(std::istream& in)
+    {
+        in.read(reinterpret_cast<char*>(&stats), sizeof(stats));
+        return in && histogram.load(in);
+    }
+};
+
+std::string toString(__int128 value)
+{
+    if (value == 0) return "0";
+    bool negative = value < 0;
+    unsigned __int128 magnitude = negative ? -static_cast<unsigned __int128>(value) : value;
+    std::string digits;
+    while (magnitude)
+    {
+        digits += static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    if (negative) digits += '-';
+    return std::string(digits.rbegin(), digits.rend());
+}
+
+
+/* Parser sink that buffers values and hands them to a Summary a block at a time. */
+class BlockSink
+{
+private:
+    Summary& summary;
+    int64_t buffer[Stats::blockSize];
+    size_t used;
+public:
+    explicit BlockSink(Summary& summary) : summary(summary), used(0) {}
+
+    void operator()(int64_t value)
+    {
+        buffer[used++] = value;
+        if (used == Stats::blockSize) flush();
+    }
+
+    void flush()
+    {
+        summary.stats.addBlock(buffer, used);
+        summary.histogram.addBlock(buffer, used);
+        used = 0;
+    }
+
+    ~BlockSink() { flush(); }
+};
+
 
-    double avg = static_cast<double>(sum) / numbers.size();
+/*
+ * Pipes, terminals and stdin cannot be mapped, so they are read through a
+ * fixed buffer. A token cut by the end of the buffer is carried over to the
+ * next read; the buffer only grows if a single token is longer than it.
+ */
+template <typename Sink>
+bool streamIntegers(int fd, Sink&& sink, std::vector<ParseError>& errors)
+{
+    std::vector<char> buffer(1 << 20);
+    size_t carry = 0;
+    size_t offset = 0;
+
+    while (true)
+    {
+        ssize_t n = read(fd, buffer.data() + carry, buffer.size() - carry);
+        if (n < 0)
+        {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        size_t length = carry + n;
+        if (n == 0)
+        {
+            parseIntegers<int64_t>(buffer.data(), buffer.data() + length, offset, sink, errors);
+            return true;
+        }
+
+        size_t cut = length;
+        while (cut > 0 && !isSeparator(buffer[cut - 1])) cut--;
+        if (cut == 0)
+        {
+            if (length == buffer.size()) buffer.resize(buffer.size() * 2);
+            carry = length;
+            continue;
+        }
+
+        parseIntegers<int64_t>(buffer.data(), buffer.data() + cut, offset, sink, errors);
+        offset += cut;
+        carry = length - cut;
+        std::memmove(buffer.data(), buffer.data() + cut, carry);
+    }
+}
+
+struct Timing
+{
+    double map = 0;
+    double parse = 0;
+    double merge = 0;
+    double output = 0;
+};
+
+double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Per-thread partial, padded to its own cache lines so threads never share one. */
+struct alignas(64) ThreadPartial
+{
+    Summary summary;
+    std::vector<ParseError> errors;
+};
+
+/*
+ * Splits a mapped file into one range per thread, each starting just after a
+ * separator so no token is cut, reduces the ranges in parallel and merges the
+ * partials in file order.
+ */
+void reduceParallel(const char* data, size_t size, unsigned threads, Summary& summary,
+    std::vector<ParseError>& errors, Timing& timing)
+{
+    std::vector<size_t> bounds(threads + 1, size);
+    bounds[0] = 0;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        size_t b = std::max(bounds[t - 1], size / threads * t);
+        while (b < size && !isSeparator(data[b])) b++;
+        bounds[t] = b;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ThreadPartial> partials(threads);
+    auto work = [&](unsigned t) {
+        BlockSink sink(partials[t].summary);
+        parseIntegers<int64_t>(data + bounds[t], data + bounds[t + 1], bounds[t], sink, partials[t].errors);
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+    timing.parse += secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (auto& partial : partials)
+    {
+        summary.merge(partial.summary);
+        errors.insert(errors.end(), partial.errors.begin(), partial.errors.end());
+    }
+    timing.merge += secondsSince(start);
+}
+
+/*
+ * Binary input format (native little-endian), written by --convert:
+ *
+ *   FileHeader, then blockCount blocks of
+ *   BlockHeader + payload
+ *
+ * A block holds up to Stats::blockSize values stored frame-of-reference:
+ * (value - min) packed in bitWidth bits each, LSB first. The payload is
+ * padded to a multiple of 8 bytes plus 16 spare bytes so decoders can always
+ * do a full-width unaligned load. Each header carries the block's exact
+ * count/sum/min/max/mean/M2, so when no per-value output (quantiles) is needed
+ * a block is merged from its header without decoding the payload.
+ */
+const char binaryMagic[8] = { 'L', '1', 'S', 'T', 'A', 'T', 'S', '\0' };
+const uint32_t binaryVersion = 1;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t blockValues;
+    uint64_t count;
+    uint64_t blockCount;
+};
+
+struct BlockHeader
+{
+    uint32_t count;
+    uint8_t bitWidth;
+    uint8_t reserved[3];
+    int64_t min;
+    int64_t max;
+    int64_t sumLow;
+    int64_t sumHigh;
+    double mean;
+    double m2;
+    uint64_t payloadBytes;
+};
+
+bool isBinaryInput(const char* data, size_t size)
+{
+    return size >= sizeof(FileHeader) && std::memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
+
+Stats blockStats(const BlockHeader& header)
+{
+    Stats stats;
+    stats.count = header.count;
+    stats.sum = (static_cast<__int128>(header.sumHigh) << 64) | static_cast<uint64_t>(header.sumLow);
+    stats.min = header.min;
+    stats.max = header.max;
+    stats.mean = header.mean;
+    stats.m2 = header.m2;
+    return stats;
+}
 
+/* Unpacks header.count values from payload into out. */
+void decodeBlock(const BlockHeader& header, const unsigned char* payload, int64_t* out)
+{
+    const unsigned width = header.bitWidth;
+    const uint64_t base = static_cast<uint64_t>(header.min);
+    const size_t n = header.count;
+    size_t i = 0;
+
+    if (width == 0)
+    {
+        std::fill(out, out + n, header.min);
+        return;
+    }
+    if (width > 57)
+    {
+        for (; i < n; i++)
+        {
+            uint64_t bit = static_cast<uint64_t>(i) * width;
+            unsigned __int128 word;
+            std::memcpy(&word, payload + (bit >> 3), sizeof(word));
+            uint64_t v = static_cast<uint64_t>(word >> (bit & 7));
+            if (width < 64) v &= (uint64_t(1) << width) - 1;
+            out[i] = static_cast<int64_t>(base + v);
+        }
+        return;
+    }
+
+    const uint64_t mask = (uint64_t(1) << width) - 1;
+#if defined(__AVX2__)
+    /* Four values per step: gather the 8 bytes holding each one, shift, mask, rebase. */
+    const __m256i vmask = _mm256_set1_epi64x(mask);
+    const __m256i vbase = _mm256_set1_epi64x(base);
+    const __m256i step = _mm256_set1_epi64x(4 * width);
+    const __m256i seven = _mm256_set1_epi64x(7);
+    __m256i bits = _mm256_setr_epi64x(0, width, 2 * width, 3 * width);
+    for (; i + 4 <= n; i += 4)
+    {
+        __m256i v = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(payload), _mm256_srli_epi64(bits, 3), 1);
+        v = _mm256_and_si256(_mm256_srlv_epi64(v, _mm256_and_si256(bits, seven)), vmask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_add_epi64(v, vbase));
+        bits = _mm256_add_epi64(bits, step);
+    }
+#endif
+    for (; i < n; i++)
+    {
+        uint64_t bit = static_cast<uint64_t>(i) * width;
+        uint64_t word;
+        std::memcpy(&word, payload + (bit >> 3), sizeof(word));
+        out[i] = static_cast<int64_t>(base + ((word >> (bit & 7)) & mask));
+    }
+}
+
+/* Writes the binary format; used as a parser sink by --convert. */
+class BinaryWriter
+{
+private:
+    std::ofstream out;
+    FileHeader header;
+    int64_t buffer[Stats::blockSize];
+    size_t used;
+    std::vector<unsigned char> payload;
+public:
+    explicit BinaryWriter(const char* path) : out(path, std::ios::binary | std::ios::trunc), used(0)
+    {
+        std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+        header.version = binaryVersion;
+        header.blockValues = Stats::blockSize;
+        header.count = 0;
+        header.blockCount = 0;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    bool is_open() const { return out.is_open(); }
+
+    void operator()(int64_t value)
+    {
+        buffer[used++] = value;
+        if (used == Stats::blockSize) flush();
+    }
+
+    void flush()
+    {
+        if (used == 0) return;
+        Stats stats;
+        stats.addBlock(buffer, used);
+
+        BlockHeader block = {};
+        block.count = static_cast<uint32_t>(used);
+        uint64_t range = static_cast<uint64_t>(stats.max) - static_cast<uint64_t>(stats.min);
+        block.bitWidth = range ? static_cast<uint8_t>(64 - __builtin_clzll(range)) : 0;
+        block.min = stats.min;
+        block.max = stats.max;
+        block.sumLow = static_cast<int64_t>(static_cast<uint64_t>(stats.sum));
+        block.sumHigh = static_cast<int64_t>(stats.sum >> 64);
+        block.mean = stats.mean;
+        block.m2 = stats.m2;
+        block.payloadBytes = ((used * block.bitWidth + 7) / 8 + 7) / 8 * 8 + 16;
+
+        payload.assign(block.payloadBytes, 0);
+        for (size_t i = 0; i < used; i++)
+        {
+            uint64_t v = static_cast<uint64_t>(buffer[i]) - static_cast<uint64_t>(stats.min);
+            uint64_t bit = static_cast<uint64_t>(i) * block.bitWidth;
+            unsigned __int128 word;
+            std::memcpy(&word, &payload[bit >> 3], sizeof(word));
+            word |= static_cast<unsigned __int128>(v) << (bit & 7);
+            std::memcpy(&payload[bit >> 3], &word, sizeof(word));
+        }
+
+        out.write(reinterpret_cast<const char*>(&block), sizeof(block));
+        out.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+        header.count += used;
+        header.blockCount++;
+        used = 0;
+    }
+
+    /* Flushes the last block and fills in the totals in the file header. */
+    bool close()
+    {
+        flush();
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.close();
+        return !out.fail();
+    }
+};
+
+/*
+ * Reduces a binary file: block offsets are collected by hopping over the
+ * headers, then blocks are shared out between threads. Payloads are only
+ * decoded when the histogram is needed.
+ */
+bool reduceBinary(const char* data, size_t size, unsigned threads, bool quantiles, Summary& summary, Timing& timing)
+{
+    FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.version != binaryVersion || header.blockValues > Stats::blockSize)
+    {
+        return false;
+    }
+    // Every block needs at least its header, so a larger count cannot be genuine
+    if (header.blockCount > (size - sizeof(FileHeader)) / sizeof(BlockHeader))
+    {
+        return false;
+    }
+
+    std::vector<size_t> offsets;
+    offsets.reserve(header.blockCount);
+    size_t offset = sizeof(FileHeader);
+    for (uint64_t b = 0; b < header.blockCount; b++)
+    {
+        BlockHeader block;
+        if (offset + sizeof(block) > size) return false;
+        std::memcpy(&block, data + offset, sizeof(block));
+        if (block.count > Stats::blockSize || block.bitWidth > 64 || block.payloadBytes > size - offset - sizeof(block)) return false;
+        // decodeBlock reads up to 16 bytes from the byte holding the last value
+        if (block.payloadBytes < (uint64_t(block.count) * block.bitWidth + 7) / 8 + 16) return false;
+        offsets.push_back(offset);
+        offset += sizeof(block) + block.payloadBytes;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<ThreadPartial> partials(threads);
+    auto work = [&](unsigned t) {
+        Summary& partial = partials[t].summary;
+        int64_t values[Stats::blockSize];
+        size_t first = offsets.size() * t / threads;
+        size_t last = offsets.size() * (t + 1) / threads;
+        for (size_t b = first; b < last; b++)
+        {
+            BlockHeader block;
+            std::memcpy(&block, data + offsets[b], sizeof(block));
+            partial.stats.merge(blockStats(block));
+            if (quantiles)
+            {
+                decodeBlock(block, reinterpret_cast<const unsigned char*>(data + offsets[b] + sizeof(block)), values);
+                partial.histogram.addBlock(values, block.count);
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threads; t++)
+    {
+        workers.emplace_back(work, t);
+    }
+    work(0);
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+    timing.parse += secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (auto& partial : partials)
+    {
+        summary.merge(partial.summary);
+    }
+    timing.merge += secondsSince(start);
+    return true;
+}
+
+/* Parses one text source ("-" is stdin) on the calling thread into sink. */
+template <typename Sink>
+bool parseSource(const char* path, Sink& sink)
+{
+    std::vector<ParseError> errors;
+    bool ok = true;
+
+    struct stat st;
+    if (std::strcmp(path, "-") != 0 && stat(path, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        MappedFile inputFile(path);
+        if (!inputFile.is_open()) return false;
+        parseIntegers<int64_t>(inputFile.data(), inputFile.data() + inputFile.size(), 0, sink, errors);
+    }
+    else
+    {
+        int fd = std::strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+        if (fd < 0) return false;
+        ok = streamIntegers(fd, sink, errors);
+        if (fd != STDIN_FILENO) close(fd);
+    }
+
+    reportErrors(path, errors);
+    return ok;
+}
+
+/* Reduces one source ("-" is stdin) into summary; regular files are mapped. */
+bool accumulateSource(const char* path, unsigned threads, bool quantiles, Summary& summary, Timing& timing)
+{
+    std::vector<ParseError> errors;
+    bool ok = true;
+
+    struct stat st;
+    if (std::strcmp(path, "-") != 0 && stat(path, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        auto start = std::chrono::steady_clock::now();
+        MappedFile inputFile(path);
+        timing.map += secondsSince(start);
+        if (!inputFile.is_open()) return false;
+        if (isBinaryInput(inputFile.data(), inputFile.size()))
+        {
+            if (!reduceBinary(inputFile.data(), inputFile.size(), threads, quantiles, summary, timing))
+            {
+                std::cout << path << ": corrupt binary input!" << std::endl;
+                return false;
+            }
+            return true;
+        }
+        reduceParallel(inputFile.data(), inputFile.size(), threads, summary, errors, timing);
+    }
+    else
+    {
+        int fd = std::strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+        if (fd < 0) return false;
+        auto start = std::chrono::steady_clock::now();
+        {
+            BlockSink sink(summary);
+            ok = streamIntegers(fd, sink, errors);
+        }
+        timing.parse += secondsSince(start);
+        if (fd != STDIN_FILENO) close(fd);
+    }
+
+    reportErrors(path, errors);
+    return ok;
+}
+
+
+void writeTable(std::ostream& out, const std::vector<std::pair<std::string, std::string>>& columns)
+{
     // Use fixed widths for each column According to the max condition, the maximum value of a single input value is 100000.
-    int colWidth = 10;
+    const int colWidth = 15;
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        out << (i ? " | " : "| ") << std::setw(5) << " " << std::setw(7) << std::left << columns[i].first;
+    }
+    out << " |" << std::endl;
 
-    outputFile << std::fixed << std::setprecision(2);
-    
-    outputFile  << "| " << std::setw(5) << " " << std::setw(7) << std::left << "Sum"
-        << " | " << std::setw(5) << " " << std::setw(7) << std::left << "Avg"
-        << " | " << std::setw(5) << " " << std::setw(7) << std::left << "Min"
-        << " | " << std::setw(5) << " " << std::setw(7) << std::left << "Max" << " |" << std::endl;
+    out << std::setw(colWidth * columns.size() + 1) << std::setfill('-') << "" << std::endl << std::setfill(' ');
 
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        out << (i ? " | " : "| ") << std::setw(3) << " " << std::setw(9) << columns[i].second;
+    }
+    out << " |" << std::endl;
+}
 
-    outputFile << std::setw((colWidth * 6) + 1) << std::setfill('-') << "" << std::endl << std::setfill(' ');
+std::string formatFixed(double value)
+{
+    std::ostringstream s;
+    s << std::fixed << std::setprecision(2) << value;
+    return s.str();
+}
 
-    
-    outputFile << "| " << std::setw(3) << " " << std::setw(9) << sum
-        << " | " << std::setw(3) << " " << std::setw(9) << avg
-        << " | " << std::setw(3) << " " << std::setw(9) << min
-        << " | " << std::setw(3) << " " << std::setw(9) << max << " |" << std::endl;
 
-    inputFile.close();
+bool writeOutput(const Summary& summary, bool quantiles)
+{
+    const Stats& total = summary.stats;
+    if (total.count == 0) 
+	{
+        std::cout << "No data in input file!" << std::endl;
+        return false;
+    }
+
+    std::ofstream outputFile("output.txt");
+    if (!outputFile.is_open())
+    {
+        std::cout << "Error opening file!" << std::endl;
+        return false;
+    }
+
+    std::vector<std::pair<std::string, std::string>> columns = {
+        { "Sum", toString(total.sum) },
+        { "Avg", formatFixed(total.average()) },
+        { "Min", std::to_string(total.min) },
+        { "Max", std::to_string(total.max) },
+        { "Count", std::to_string(total.count) },
+        { "Stddev", formatFixed(std::sqrt(total.variance())) },
+    };
+    if (quantiles)
+    {
+        columns.push_back({ "p50", std::to_string(summary.histogram.quantile(0.50, total.count, total.min, total.max)) });
+        columns.push_back({ "p90", std::to_string(summary.histogram.quantile(0.90, total.count, total.min, total.max)) });
+        columns.push_back({ "p99", std::to_string(summary.histogram.quantile(0.99, total.count, total.min, total.max)) });
+        columns.push_back({ "p999", std::to_string(summary.histogram.quantile(0.999, total.count, total.min, total.max)) });
+    }
+    writeTable(outputFile, columns);
+
     outputFile.close();
+    return !outputFile.fail();
+}
+
+
+/*
+ * Checkpoint for incremental runs over an append-only text input: which file
+ * (device + inode), how far into it has been reduced, and the Summary so far.
+ * It is written to a temporary file and renamed, so a crash mid-write leaves
+ * the previous checkpoint intact.
+ */
+const char checkpointMagic[8] = { 'L', '1', 'C', 'K', 'P', 'T', '\0', '\0' };
+const uint32_t checkpointVersion = 1;
+
+struct CheckpointHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t device;
+    uint64_t inode;
+    uint64_t offset;
+};
+
+bool loadCheckpoint(const char* path, CheckpointHeader& header, Summary& summary)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) return false;
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+    return in && std::memcmp(header.magic, checkpointMagic, sizeof(checkpointMagic)) == 0
+        && header.version == checkpointVersion && summary.load(in);
+}
+
+bool saveCheckpoint(const char* path, const CheckpointHeader& header, const Summary& summary)
+{
+    std::string temp = std::string(path) + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        summary.save(out);
+        out.close();
+        if (out.fail()) return false;
+    }
+    return std::rename(temp.c_str(), path) == 0;
+}
+
+/*
+ * Reduces whatever was appended to path since the checkpoint, up to the last
+ * complete token, then rewrites output.txt and the checkpoint. A file that
+ * was replaced (new inode) or truncated is reduced again from the start.
+ */
+bool refreshIncremental(const char* path, const char* checkpointPath, unsigned threads, bool quantiles)
+{
+    struct stat st;
+    if (stat(path, &st) < 0 || !S_ISREG(st.st_mode)) return false;
+
+    CheckpointHeader header;
+    Summary summary;
+    if (!loadCheckpoint(checkpointPath, header, summary)
+        || header.device != static_cast<uint64_t>(st.st_dev) || header.inode != static_cast<uint64_t>(st.st_ino)
+        || header.offset > static_cast<uint64_t>(st.st_size))
+    {
+        std::memcpy(header.magic, checkpointMagic, sizeof(checkpointMagic));
+        header.version = checkpointVersion;
+        header.reserved = 0;
+        header.device = st.st_dev;
+        header.inode = st.st_ino;
+        header.offset = 0;
+        summary = Summary();
+    }
+
+    MappedFile inputFile(path);
+    if (!inputFile.is_open()) return false;
+
+    /* A last token without a trailing separator may still be being written. */
+    size_t end = inputFile.size();
+    while (end > header.offset && !isSeparator(inputFile.data()[end - 1])) end--;
+    if (end == header.offset) return true;
+
+    std::vector<ParseError> errors;
+    Timing timing;
+    Summary delta;
+    reduceParallel(inputFile.data() + header.offset, end - header.offset, threads, delta, errors, timing);
+    for (auto& error : errors)
+    {
+        error.offset += header.offset;
+    }
+    reportErrors(path, errors);
+
+    summary.merge(delta);
+    header.offset = end;
+    if (summary.stats.count > 0 && !writeOutput(summary, quantiles)) return false;
+    return saveCheckpoint(checkpointPath, header, summary);
+}
+
+/* Refreshes once, then again every time inotify reports a change to path. */
+bool follow(const char* path, const char* checkpointPath, unsigned threads, bool quantiles)
+{
+    int fd = inotify_init1(IN_CLOEXEC);
+    if (fd < 0) return false;
+
+    while (true)
+    {
+        int watch = inotify_add_watch(fd, path, IN_MODIFY | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+        if (watch < 0)
+        {
+            /* Rotated away and not recreated yet. */
+            sleep(1);
+            continue;
+        }
+        if (!refreshIncremental(path, checkpointPath, threads, quantiles))
+        {
+            close(fd);
+            return false;
+        }
+
+        bool replaced = false;
+        bool dropped = false;
+        while (!replaced)
+        {
+            alignas(inotify_event) char events[4096];
+            ssize_t n = read(fd, events, sizeof(events));
+            if (n < 0)
+            {
+                if (errno == EINTR) continue;
+                close(fd);
+                return false;
+            }
+            for (char* p = events; p < events + n; p += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(p)->len)
+            {
+                const inotify_event* event = reinterpret_cast<inotify_event*>(p);
+                /* Events for a watch removed on an earlier pass may still be queued. */
+                if (event->wd != watch) continue;
+                if (event->mask & (IN_MOVE_SELF | IN_DELETE_SELF | IN_IGNORED))
+                {
+                    replaced = true;
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    dropped = true;
+                }
+            }
+            if (!replaced && !refreshIncremental(path, checkpointPath, threads, quantiles))
+            {
+                close(fd);
+                return false;
+            }
+        }
+        /* After IN_IGNORED the kernel has already removed the watch. */
+        if (!dropped) inotify_rm_watch(fd, watch);
+    }
+}
+
+
+/*
+ * Lab1 [--threads N] [--timing] [--no-quantiles] [input...]
+ * Lab1 --convert output.bin [input...]
+ * Lab1 [--checkpoint state] [--follow] [input]  (append-only text input)
+ * Inputs are text or binary files, or "-" for stdin; default input.txt.
+ */
+int main(int argc, char* argv[]) {
+    std::vector<const char*> sources;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    bool showTiming = false;
+    bool quantiles = true;
+    const char* convertPath = nullptr;
+    const char* checkpointPath = nullptr;
+    bool following = false;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+        {
+            threads = std::max(1, std::atoi(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--timing") == 0)
+        {
+            showTiming = true;
+        }
+        else if (std::strcmp(argv[i], "--no-quantiles") == 0)
+        {
+            quantiles = false;
+        }
+        else if (std::strcmp(argv[i], "--convert") == 0 && i + 1 < argc)
+        {
+            convertPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+        {
+            checkpointPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--follow") == 0)
+        {
+            following = true;
+        }
+        else
+        {
+            sources.push_back(argv[i]);
+        }
+    }
+    if (sources.empty())
+    {
+        sources.push_back("input.txt");
+    }
+
+    if (convertPath)
+    {
+        BinaryWriter writer(convertPath);
+        if (!writer.is_open())
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return 1;
+        }
+        for (const char* source : sources)
+        {
+            if (!parseSource(source, writer))
+            {
+                std::cout << "Error opening file!" << std::endl;
+                return 1;
+            }
+        }
+        return writer.close() ? 0 : 1;
+    }
+
+    if (checkpointPath || following)
+    {
+        if (sources.size() != 1)
+        {
+            std::cout << "Incremental mode takes exactly one input file!" << std::endl;
+            return 1;
+        }
+        std::string defaultCheckpoint = std::string(sources[0]) + ".checkpoint";
+        const char* state = checkpointPath ? checkpointPath : defaultCheckpoint.c_str();
+        bool ok = following
+            ? follow(sources[0], state, threads, quantiles)
+            : refreshIncremental(sources[0], state, threads, quantiles);
+        if (!ok)
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    Summary summary;
+    Timing timing;
+    for (const char* source : sources)
+    {
+        Summary partial;
+        if (!accumulateSource(source, threads, quantiles, partial, timing))
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return 1;
+        }
+        summary.merge(partial);
+    }
+
+    auto outputStart = std::chrono::steady_clock::now();
+    if (!writeOutput(summary, quantiles))
+    {
+        return 1;
+    }
+    timing.output = secondsSince(outputStart);
+
+    if (showTiming)
+    {
+        std::cout << std::fixed << std::setprecision(3)
+            << "threads: " << threads << std::endl
+            << "map:     " << timing.map << " s" << std::endl
+            << "parse:   " << timing.parse << " s" << std::endl
+            << "merge:   " << timing.merge << " s" << std::endl
+            << "output:  " << timing.output << " s" << std::endl;
+    }
 
     return 0;
 }
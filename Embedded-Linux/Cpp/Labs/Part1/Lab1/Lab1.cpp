@@ -2,39 +2,95 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
 
 
 
-void ArrayOfString(void)
+/*
+ * All strings live back to back in one growing byte arena; an index of
+ * (offset, length) pairs locates each one. Adding a string is an append to
+ * the arena instead of a malloc, there is no length limit, and clear() frees
+ * everything at once. Views returned by get() stay valid until the next add().
+ */
+class StringPool
 {
-    int size;
-    int len;
-    char in[50];
+private:
+    struct Entry
+    {
+        size_t offset;
+        size_t length;
+    };
 
-    std::cout << "Size : ";
-    std::cin >> size;
+    std::vector<char> arena;
+    std::vector<Entry> index;
 
-    char** strings = (char**)malloc(sizeof(char*) * size);
+public:
+    void reserve(size_t strings, size_t bytes)
+    {
+        index.reserve(strings);
+        arena.reserve(bytes);
+    }
 
-    
+    size_t add(std::string_view s)
+    {
+        index.push_back({ arena.size(), s.size() });
+        arena.insert(arena.end(), s.begin(), s.end());
+        return index.size() - 1;
+    }
+
+    std::string_view get(size_t i) const
+    {
+        return std::string_view(arena.data() + index[i].offset, index[i].length);
+    }
+
+    std::string_view operator[](size_t i) const
+    {
+        return get(i);
+    }
 
-    for (int i = 0; i < size; i++)
+    size_t size() const
     {
-        std::cin >> in;
-        len = strlen(in);
-        strings[i] = (char*)malloc((sizeof(char) * len) + 1);
+        return index.size();
+    }
+
+    size_t bytes() const
+    {
+        return arena.size();
+    }
+
+    /* Releases every string and the memory behind them in one go. */
+    void clear()
+    {
+        std::vector<char>().swap(arena);
+        std::vector<Entry>().swap(index);
+    }
+};
+
 
+void ArrayOfString(void)
+{
+    int size;
+    std::string in;
+    StringPool strings;
 
-        for (int j = 0; in[j]; j++)
-        {
-            strings[i][j] = in[j];
-        }
-        strings[i][len] = '\0';
+    std::cout << "Size : ";
+    std::cin >> size;
 
+    // A negative size reads nothing, as before; a huge one only reserves part up front
+    if (size > 0)
+    {
+        strings.reserve(std::min(size, 1 << 16), 0);
+    }
+    for (int i = 0; i < size && std::cin >> in; i++)
+    {
+        strings.add(in);
     }
 
 
-    for (int i = 0; i < size; i++)
+    for (size_t i = 0; i < strings.size(); i++)
     {
         std::cout << strings[i] << std::endl;
     }
@@ -2,23 +2,16 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string.h>
-
-
-typedef struct
-{
-    int* Arr;
-    int size;
-    int Actualsize;
-
-}Vector_t;
+#include <chrono>
+#include "vec.h"
 
 
 void DynamicArray(Vector_t *pV, int Size)
 {
+    vec_init(pV);
+    vec_reserve(pV, Size + 10);
     pV->size = Size;
-    pV->Actualsize = pV->size + 10;
 
-    pV->Arr = (int*)malloc(sizeof(int) * pV->Actualsize);
     std::cout << "Enter data : ";
     for (int i = 0; i < pV->size; i++)
     {
@@ -29,50 +22,93 @@ void DynamicArray(Vector_t *pV, int Size)
 
 int insert(Vector_t* pV, int index, int n)
 {
-    int Status = 1;
+    int Status = 0;
     if (index < pV->size)
     {
-        pV->size++;
-        if (pV->Actualsize < pV->size)
-        {
-            pV->Actualsize += 5;
-            pV->Arr = (int*)realloc(pV->Arr, sizeof(int) * pV->Actualsize);
-        }
-
-
-        for (int i = pV->size; i >= index; i--)
-        {
-            pV->Arr[i] = pV->Arr[i - 1];
-        }
-
-        pV->Arr[index] = n;
-    }
-    else
-    {
-        Status = 0;
+        Status = vec_insert(pV, index, n);
     }
     return Status;
 }
 
 int Delete(Vector_t* pV, int index)
 {
+    return vec_erase(pV, index);
+}
 
-    int Status = 1;
-    if (index < pV->size)
+
+/*
+ * Appends, then middle inserts into the first base elements, through the old
+ * scheme (grow by 5 per realloc, shift with an element loop) against the
+ * vec_* API.
+ */
+void Benchmark(int appends, int base, int inserts)
+{
+    auto seconds = [](auto start) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    Vector_t old;
+    vec_init(&old);
+    long oldReallocs = 0;
+    for (int i = 0; i < appends; i++)
     {
-        for (int i = index; i < pV->size; i++)
+        old.size++;
+        if (old.Actualsize < old.size)
         {
-            pV->Arr[i] = pV->Arr[i + 1];
+            oldReallocs++;
+            old.Actualsize += 5;
+            old.Arr = (int*)realloc(old.Arr, sizeof(int) * old.Actualsize);
         }
-        pV->size--;
+        old.Arr[old.size - 1] = i;
     }
-    else
+    double oldAppend = seconds(start);
+    old.size = base;
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < inserts; k++)
     {
-        Status = 0;
+        int index = old.size / 2;
+        old.size++;
+        if (old.Actualsize < old.size)
+        {
+            old.Actualsize += 5;
+            old.Arr = (int*)realloc(old.Arr, sizeof(int) * old.Actualsize);
+        }
+        for (int i = old.size - 1; i > index; i--)
+        {
+            old.Arr[i] = old.Arr[i - 1];
+        }
+        old.Arr[index] = k;
     }
-    return Status;
-    
-    
+    double oldInsert = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    Vector_t vec;
+    vec_init(&vec);
+    long newReallocs = 0;
+    for (int i = 0; i < appends; i++)
+    {
+        int capacity = vec.Actualsize;
+        vec_push(&vec, i);
+        newReallocs += (vec.Actualsize != capacity);
+    }
+    double newAppend = seconds(start);
+    vec_erase_range(&vec, base, vec.size);
+
+    start = std::chrono::steady_clock::now();
+    for (int k = 0; k < inserts; k++)
+    {
+        vec_insert(&vec, vec.size / 2, k);
+    }
+    double newInsert = seconds(start);
+
+    std::cout << appends << " appends:  grow-by-5 " << oldAppend << " s (" << oldReallocs << " reallocs), geometric "
+        << newAppend << " s (" << newReallocs << " reallocs)\n";
+    std::cout << inserts << " inserts into " << base << ":  loop shift " << oldInsert << " s, memmove " << newInsert << " s\n";
+
+    vec_free(&old);
+    vec_free(&vec);
 }
 
 
@@ -105,8 +141,14 @@ int PrintIndex(Vector_t* pV, int index)
 
 
 
-int main()
+int main(int argc, char* argv[])
 {
+    if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+    {
+        Benchmark(10000000, 100000, 50000);
+        return 0;
+    }
+
     int index;
     int n;
     Vector_t V;
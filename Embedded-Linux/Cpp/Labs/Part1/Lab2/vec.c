@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <limits.h>
+#include "vec.h"
+
+void vec_init(Vector_t* pV)
+{
+    pV->Arr = NULL;
+    pV->size = 0;
+    pV->Actualsize = 0;
+}
+
+void vec_free(Vector_t* pV)
+{
+    free(pV->Arr);
+    vec_init(pV);
+}
+
+int vec_reserve(Vector_t* pV, int capacity)
+{
+    if (capacity <= pV->Actualsize)
+    {
+        return 1;
+    }
+    if ((size_t)capacity > SIZE_MAX / sizeof(int))
+    {
+        return 0;
+    }
+    int* Arr = (int*)realloc(pV->Arr, sizeof(int) * capacity);
+    if (Arr == NULL)
+    {
+        return 0;
+    }
+    pV->Arr = Arr;
+    pV->Actualsize = capacity;
+    return 1;
+}
+
+/* Grows capacity by 1.5x (at least to needed, at most INT_MAX) when needed exceeds it. */
+static int vec_grow(Vector_t* pV, int needed)
+{
+    if (needed <= pV->Actualsize)
+    {
+        return 1;
+    }
+    int capacity = INT_MAX;
+    if (pV->Actualsize <= INT_MAX - pV->Actualsize / 2)
+    {
+        capacity = pV->Actualsize + pV->Actualsize / 2;
+    }
+    if (capacity < needed)
+    {
+        capacity = needed;
+    }
+    if (capacity < 8)
+    {
+        capacity = 8;
+    }
+    return vec_reserve(pV, capacity);
+}
+
+int vec_push(Vector_t* pV, int n)
+{
+    if (pV->size == INT_MAX || !vec_grow(pV, pV->size + 1))
+    {
+        return 0;
+    }
+    pV->Arr[pV->size++] = n;
+    return 1;
+}
+
+int vec_insert_n(Vector_t* pV, int index, const int* values, int count)
+{
+    if (index < 0 || index > pV->size || count < 0 || count > INT_MAX - pV->size)
+    {
+        return 0;
+    }
+    if (count == 0)
+    {
+        return 1;
+    }
+
+    /* values inside the vector: remember where, since growing and shifting move them */
+    uintptr_t address = (uintptr_t)values, begin = (uintptr_t)pV->Arr;
+    int inside = pV->Arr != NULL && address >= begin && address < begin + sizeof(int) * pV->size;
+    int from = inside ? (int)((address - begin) / sizeof(int)) : 0;
+
+    if (!vec_grow(pV, pV->size + count))
+    {
+        return 0;
+    }
+    memmove(pV->Arr + index + count, pV->Arr + index, sizeof(int) * (pV->size - index));
+    if (!inside)
+    {
+        memcpy(pV->Arr + index, values, sizeof(int) * count);
+    }
+    else
+    {
+        /* Values before index stayed put, the rest moved up by count */
+        int before = from < index ? index - from : 0;
+        if (before > count)
+        {
+            before = count;
+        }
+        memcpy(pV->Arr + index, pV->Arr + from, sizeof(int) * before);
+        memcpy(pV->Arr + index + before, pV->Arr + from + before + count, sizeof(int) * (count - before));
+    }
+    pV->size += count;
+    return 1;
+}
+
+int vec_insert(Vector_t* pV, int index, int n)
+{
+    return vec_insert_n(pV, index, &n, 1);
+}
+
+int vec_erase_range(Vector_t* pV, int first, int last)
+{
+    if (first < 0 || first > last || last > pV->size)
+    {
+        return 0;
+    }
+    memmove(pV->Arr + first, pV->Arr + last, sizeof(int) * (pV->size - last));
+    pV->size -= last - first;
+    return 1;
+}
+
+int vec_erase(Vector_t* pV, int index)
+{
+    return vec_erase_range(pV, index, index + 1);
+}
+
+int vec_shrink(Vector_t* pV)
+{
+    if (pV->size == pV->Actualsize)
+    {
+        return 1;
+    }
+    if (pV->size == 0)
+    {
+        vec_free(pV);
+        return 1;
+    }
+    int* Arr = (int*)realloc(pV->Arr, sizeof(int) * pV->size);
+    if (Arr == NULL)
+    {
+        return 0;
+    }
+    pV->Arr = Arr;
+    pV->Actualsize = pV->size;
+    return 1;
+}
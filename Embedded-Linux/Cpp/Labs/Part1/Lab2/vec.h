@@ -0,0 +1,49 @@
+#ifndef VEC_H
+#define VEC_H
+
+/*
+ * Growable int array with a C API, used by Lab2.cpp and callable from C.
+ * Build: gcc -c vec.c && g++ Lab2.cpp vec.o -o Lab2
+ *
+ * Capacity grows geometrically, so n appends cost O(n) in total, and
+ * insert/erase shift with one memmove. Functions return 1 on success and 0 on
+ * a bad index, a size that would not fit in an int, or a failed allocation,
+ * leaving the vector as it was.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    int* Arr;
+    int size;
+    int Actualsize;
+
+}Vector_t;
+
+void vec_init(Vector_t* pV);
+void vec_free(Vector_t* pV);
+
+/* Makes room for at least capacity elements without changing size. */
+int vec_reserve(Vector_t* pV, int capacity);
+
+int vec_push(Vector_t* pV, int n);
+
+/* Inserts count values before index; index == size appends. values may point into the vector itself. */
+int vec_insert_n(Vector_t* pV, int index, const int* values, int count);
+int vec_insert(Vector_t* pV, int index, int n);
+
+/* Removes elements [first, last). */
+int vec_erase_range(Vector_t* pV, int first, int last);
+int vec_erase(Vector_t* pV, int index);
+
+/* Gives back unused capacity. */
+int vec_shrink(Vector_t* pV);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -2,6 +2,10 @@
 #include <iostream>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <climits>
 
 
 
@@ -11,6 +15,143 @@ typedef int (OperationCallback)(int*, int);
 typedef int* (*CallbackFunction)(int** arr_2d, int arr_size, int* row_sizes, OperationCallback);
 
 
+/*
+ * Jagged 2D array in CSR form: all rows back to back in one values array,
+ * row i being values[offsets[i], offsets[i + 1]).
+ */
+struct JaggedArray
+{
+    std::vector<int> values;
+    std::vector<size_t> offsets;
+
+    JaggedArray() : offsets(1, 0)
+    {
+    }
+
+    static JaggedArray FromRows(int** arr_2d, int arr_size, const int* row_sizes)
+    {
+        JaggedArray result;
+        result.offsets.reserve(arr_size + 1);
+        for (int i = 0; i < arr_size; i++)
+        {
+            result.AddRow(arr_2d[i], row_sizes[i]);
+        }
+        return result;
+    }
+
+    void AddRow(const int* row, size_t size)
+    {
+        values.insert(values.end(), row, row + size);
+        offsets.push_back(values.size());
+    }
+
+    size_t Rows() const
+    {
+        return offsets.size() - 1;
+    }
+};
+
+struct MaxOp
+{
+    static int Identity() { return INT_MIN; }
+    int operator()(int a, int b) const { return a > b ? a : b; }
+};
+
+struct MinOp
+{
+    static int Identity() { return INT_MAX; }
+    int operator()(int a, int b) const { return a < b ? a : b; }
+};
+
+struct SumOp
+{
+    static int Identity() { return 0; }
+    int operator()(int a, int b) const { return a + b; }
+};
+
+/*
+ * Reduces one row with eight independent accumulators, which the compiler
+ * turns into packed SIMD min/max/add once Op is inlined. Op must be
+ * associative and commutative; init is its identity.
+ */
+template <typename Op>
+inline int ReduceRow(const int* row, size_t size, Op op, int init)
+{
+    int acc[8] = { init, init, init, init, init, init, init, init };
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        for (int k = 0; k < 8; k++)
+        {
+            acc[k] = op(acc[k], row[i + k]);
+        }
+    }
+    for (; i < size; i++)
+    {
+        acc[0] = op(acc[0], row[i]);
+    }
+    for (int k = 1; k < 8; k++)
+    {
+        acc[0] = op(acc[0], acc[k]);
+    }
+    return acc[0];
+}
+
+/*
+ * One result per row, each row folded starting from init (custom functors
+ * and lambdas). When the array holds more than parallelThreshold values, rows
+ * are split into ranges of roughly equal value count, one per thread.
+ */
+template <typename Op>
+std::vector<int> ReduceRowsFrom(const JaggedArray& arr, Op op, int init, unsigned threads = 0)
+{
+    const size_t parallelThreshold = 1 << 20;
+    const size_t rows = arr.Rows();
+    std::vector<int> result(rows);
+
+    auto work = [&](size_t first, size_t last) {
+        for (size_t r = first; r < last; r++)
+        {
+            result[r] = ReduceRow(arr.values.data() + arr.offsets[r], arr.offsets[r + 1] - arr.offsets[r], op, init);
+        }
+    };
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (threads == 1 || arr.values.size() < parallelThreshold || rows < 2)
+    {
+        work(0, rows);
+        return result;
+    }
+
+    std::vector<std::thread> workers;
+    size_t first = 0;
+    for (unsigned t = 1; t <= threads && first < rows; t++)
+    {
+        size_t target = arr.values.size() / threads * t;
+        size_t last = (t == threads) ? rows
+            : std::upper_bound(arr.offsets.begin() + first + 1, arr.offsets.end() - 1, target) - arr.offsets.begin();
+        workers.emplace_back(work, first, last);
+        first = last;
+    }
+    for (auto& w : workers)
+    {
+        w.join();
+    }
+    return result;
+}
+
+/* Same for operations that know their identity: MaxOp, MinOp, SumOp. */
+template <typename Op>
+std::vector<int> ReduceRows(const JaggedArray& arr, Op op, unsigned threads = 0)
+{
+    return ReduceRowsFrom(arr, op, Op::Identity(), threads);
+}
+
+
+/* C callback interface, kept for existing callers; see ReduceRows for the fast path. */
 int* arr2D_Proccess(int** arr_2d, int arr_size, int* row_sizes, OperationCallback Local_Operation)
 {
     int* result_arr = (int*)malloc(sizeof(int) * arr_size);
@@ -61,5 +202,17 @@ int main()
 
     free(result_arr);
 
+    JaggedArray jagged = JaggedArray::FromRows(arr, 4, arr_sizes);
+    for (int Max : ReduceRows(jagged, MaxOp()))
+    {
+        std::cout << Max << "  ";
+    }
+    std::cout << std::endl;
+    for (int Sum : ReduceRows(jagged, SumOp()))
+    {
+        std::cout << Sum << "  ";
+    }
+    std::cout << std::endl;
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,603 @@
+#ifndef RECORD_LOADER_H
+#define RECORD_LOADER_H
+
+/*
+ * Parallel loader for CSV and JSON Lines exports, shared by the Employee
+ * (Task1/Q5.cpp) and Car (Task2/Q1.cpp) tasks.
+ *
+ * The file is mapped and cut into one chunk per thread. A first parallel pass
+ * counts quotes and newlines per chunk with SIMD compares + movemask; a prefix
+ * over those counts gives every chunk its starting line number and whether it
+ * starts inside a quoted CSV field. A second parallel pass classifies 64 bytes
+ * at a time (quote mask -> prefix-XOR -> "inside quotes" mask) to find the
+ * newlines that end records, and parses each record it owns straight into a
+ * Record through the caller's field setters. Chunks keep their records in
+ * file order and are concatenated at the end.
+ *
+ * CSV: RFC 4180 quoting ("" is a literal quote, quoted fields may contain
+ * commas and newlines), first line is the header. JSON Lines: one object per
+ * line, nested objects are flattened to dotted keys ("name.firstName"); a
+ * wrapping '[' ... ']' with one object per line and trailing commas is also
+ * accepted. JSON strings cannot hold raw newlines, so JSON records end at
+ * every newline and quotes are not tracked.
+ */
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <charconv>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace RecordLoader
+{
+    struct LoadError
+    {
+        size_t line;
+        std::string message;
+    };
+
+    /* Column (CSV) or dotted key (JSON) name, and how to store its text in a Record. */
+    template <typename Record>
+    struct Field
+    {
+        const char* name;
+        bool (*set)(Record& record, std::string_view value);
+    };
+
+    template <typename Record>
+    struct Result
+    {
+        bool opened = false;
+        std::vector<Record> records;
+        std::vector<LoadError> errors;
+    };
+
+    inline bool ParseInt(std::string_view text, int& out)
+    {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    inline bool ParseDouble(std::string_view text, double& out)
+    {
+        auto result = std::from_chars(text.data(), text.data() + text.size(), out);
+        return result.ec == std::errc() && result.ptr == text.data() + text.size();
+    }
+
+    namespace Detail
+    {
+        /* Bit i set where block[i] == c, for a 64-byte block. */
+        inline uint64_t Match64(const char* block, char c)
+        {
+#if defined(__SSE2__)
+            const __m128i needle = _mm_set1_epi8(c);
+            uint64_t mask = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+                mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle)))) << (16 * i);
+            }
+            return mask;
+#else
+            uint64_t mask = 0;
+            for (int i = 0; i < 64; i++)
+            {
+                mask |= static_cast<uint64_t>(block[i] == c) << i;
+            }
+            return mask;
+#endif
+        }
+
+        /* Bit i of the result is the XOR of bits 0..i: 1 between an opening and closing quote. */
+        inline uint64_t PrefixXor(uint64_t x)
+        {
+            x ^= x << 1;
+            x ^= x << 2;
+            x ^= x << 4;
+            x ^= x << 8;
+            x ^= x << 16;
+            x ^= x << 32;
+            return x;
+        }
+
+        /*
+         * Classifies [begin, end) 64 bytes at a time (the tail is copied into a
+         * padded block). Calls onBlock(offset, newlines, quotes, recordEnds) per
+         * block, where recordEnds are the newlines outside quotes; onBlock returns
+         * false to stop. inQuotes carries the quote state across calls.
+         */
+        template <typename F>
+        void Classify(const char* begin, const char* end, bool trackQuotes, bool& inQuotes, F onBlock)
+        {
+            for (const char* p = begin; p < end; p += 64)
+            {
+                const char* block = p;
+                char tail[64];
+                size_t valid = std::min<size_t>(64, end - p);
+                if (valid < 64)
+                {
+                    std::memset(tail, 0, sizeof(tail));
+                    std::memcpy(tail, p, valid);
+                    block = tail;
+                }
+                uint64_t newlines = Match64(block, '\n');
+                uint64_t quotes = trackQuotes ? Match64(block, '"') : 0;
+                uint64_t recordEnds = newlines;
+                if (trackQuotes)
+                {
+                    uint64_t inside = PrefixXor(quotes) ^ (inQuotes ? ~uint64_t(0) : 0);
+                    inQuotes = (inside >> 63) != 0;
+                    recordEnds &= ~inside;
+                }
+                if (!onBlock(static_cast<size_t>(p - begin), newlines, quotes, recordEnds))
+                {
+                    return;
+                }
+            }
+        }
+
+        inline std::string_view TrimCr(std::string_view s)
+        {
+            if (!s.empty() && s.back() == '\r') s.remove_suffix(1);
+            return s;
+        }
+
+        /* Splits one CSV record into fields, unquoting into scratch where needed. */
+        inline bool SplitCsv(std::string_view record, std::vector<std::string_view>& fields, std::deque<std::string>& scratch)
+        {
+            fields.clear();
+            size_t used = 0;
+            size_t i = 0;
+            while (true)
+            {
+                if (i < record.size() && record[i] == '"')
+                {
+                    if (used == scratch.size()) scratch.emplace_back();
+                    std::string& value = scratch[used++];
+                    value.clear();
+                    i++;
+                    while (true)
+                    {
+                        if (i >= record.size()) return false;
+                        if (record[i] == '"')
+                        {
+                            if (i + 1 < record.size() && record[i + 1] == '"')
+                            {
+                                value += '"';
+                                i += 2;
+                                continue;
+                            }
+                            i++;
+                            break;
+                        }
+                        value += record[i++];
+                    }
+                    fields.push_back(value);
+                    if (i < record.size() && record[i] != ',') return false;
+                }
+                else
+                {
+                    size_t comma = record.find(',', i);
+                    size_t stop = comma == std::string_view::npos ? record.size() : comma;
+                    fields.push_back(record.substr(i, stop - i));
+                    i = stop;
+                }
+                if (i >= record.size()) return true;
+                i++;
+            }
+        }
+
+        inline void SkipSpace(std::string_view s, size_t& i)
+        {
+            while (i < s.size() && (s[i] == ' ' || s[i] == '\t' || s[i] == '\r')) i++;
+        }
+
+        inline void AppendUtf8(std::string& out, unsigned code)
+        {
+            if (code < 0x80)
+            {
+                out += static_cast<char>(code);
+            }
+            else if (code < 0x800)
+            {
+                out += static_cast<char>(0xC0 | (code >> 6));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += static_cast<char>(0xE0 | (code >> 12));
+                out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+                out += static_cast<char>(0x80 | (code & 0x3F));
+            }
+        }
+
+        /* JSON string starting at s[i] == '"'; escapes are decoded into out. */
+        inline bool ParseJsonString(std::string_view s, size_t& i, std::string& out)
+        {
+            out.clear();
+            i++;
+            while (i < s.size())
+            {
+                char c = s[i++];
+                if (c == '"') return true;
+                if (c != '\\')
+                {
+                    out += c;
+                    continue;
+                }
+                if (i >= s.size()) return false;
+                char e = s[i++];
+                switch (e)
+                {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u':
+                {
+                    unsigned code = 0;
+                    if (i + 4 > s.size() || std::from_chars(s.data() + i, s.data() + i + 4, code, 16).ptr != s.data() + i + 4) return false;
+                    AppendUtf8(out, code);
+                    i += 4;
+                    break;
+                }
+                default:
+                    return false;
+                }
+            }
+            return false;
+        }
+
+        /* Flat or nested JSON object at s[i] == '{'; calls onValue(dottedKey, text) per scalar. */
+        template <typename F>
+        bool ParseJsonObject(std::string_view s, size_t& i, std::string& prefix, F& onValue, std::string& scratch, std::string& key)
+        {
+            i++;
+            SkipSpace(s, i);
+            if (i < s.size() && s[i] == '}')
+            {
+                i++;
+                return true;
+            }
+            while (i < s.size())
+            {
+                SkipSpace(s, i);
+                if (i >= s.size() || s[i] != '"' || !ParseJsonString(s, i, key)) return false;
+                SkipSpace(s, i);
+                if (i >= s.size() || s[i++] != ':') return false;
+                SkipSpace(s, i);
+                if (i >= s.size()) return false;
+
+                size_t prefixLength = prefix.size();
+                prefix += key;
+                if (s[i] == '{')
+                {
+                    prefix += '.';
+                    if (!ParseJsonObject(s, i, prefix, onValue, scratch, key)) return false;
+                }
+                else if (s[i] == '"')
+                {
+                    if (!ParseJsonString(s, i, scratch)) return false;
+                    if (!onValue(prefix, std::string_view(scratch))) return false;
+                }
+                else if (s[i] == '[')
+                {
+                    return false;
+                }
+                else
+                {
+                    size_t start = i;
+                    while (i < s.size() && s[i] != ',' && s[i] != '}' && s[i] != ' ' && s[i] != '\t' && s[i] != '\r') i++;
+                    std::string_view literal = s.substr(start, i - start);
+                    if (literal != "null" && !onValue(prefix, literal)) return false;
+                }
+                prefix.resize(prefixLength);
+
+                SkipSpace(s, i);
+                if (i >= s.size()) return false;
+                if (s[i] == '}')
+                {
+                    i++;
+                    return true;
+                }
+                if (s[i++] != ',') return false;
+            }
+            return false;
+        }
+
+        /* Per-thread parsing state and output. */
+        template <typename Record>
+        struct alignas(64) Chunk
+        {
+            size_t begin = 0;
+            size_t end = 0;
+            size_t quotes = 0;
+            size_t newlines = 0;
+            size_t firstLine = 1;
+            bool startsInQuotes = false;
+            std::vector<Record> records;
+            std::vector<LoadError> errors;
+        };
+
+        template <typename Record>
+        class Parser
+        {
+        private:
+            const std::vector<Field<Record>>& fields;
+            const Record& blank;
+            bool csv;
+            std::vector<int> columnField;
+            std::vector<std::string_view> values;
+            std::deque<std::string> scratch;
+            std::string prefix, jsonScratch, jsonKey;
+
+        public:
+            Parser(const std::vector<Field<Record>>& fields, const Record& blank, bool csv, const std::vector<int>& columnField)
+                : fields(fields), blank(blank), csv(csv), columnField(columnField)
+            {
+            }
+
+            void Parse(std::string_view text, size_t line, std::vector<Record>& out, std::vector<LoadError>& errors)
+            {
+                text = TrimCr(text);
+                if (csv)
+                {
+                    if (text.empty()) return;
+                    if (!SplitCsv(text, values, scratch))
+                    {
+                        errors.push_back({ line, "unterminated or misplaced quote" });
+                        return;
+                    }
+                    if (values.size() != columnField.size())
+                    {
+                        errors.push_back({ line, "expected " + std::to_string(columnField.size()) + " fields, got " + std::to_string(values.size()) });
+                        return;
+                    }
+                    Record record = blank;
+                    for (size_t c = 0; c < values.size(); c++)
+                    {
+                        int f = columnField[c];
+                        if (f >= 0 && !fields[f].set(record, values[c]))
+                        {
+                            errors.push_back({ line, std::string("bad value for ") + fields[f].name + ": \"" + std::string(values[c]) + "\"" });
+                            return;
+                        }
+                    }
+                    out.push_back(std::move(record));
+                    return;
+                }
+
+                size_t i = 0;
+                SkipSpace(text, i);
+                if (i < text.size() && text[i] == '[') i++;
+                SkipSpace(text, i);
+                if (i >= text.size() || text[i] == ']') return;
+                if (text[i] != '{')
+                {
+                    errors.push_back({ line, "expected a JSON object" });
+                    return;
+                }
+                Record record = blank;
+                std::string failed;
+                auto onValue = [&](const std::string& key, std::string_view value) {
+                    for (const Field<Record>& field : fields)
+                    {
+                        if (key == field.name)
+                        {
+                            if (field.set(record, value)) return true;
+                            failed = key;
+                            return false;
+                        }
+                    }
+                    return true;
+                };
+                prefix.clear();
+                if (!ParseJsonObject(text, i, prefix, onValue, jsonScratch, jsonKey))
+                {
+                    errors.push_back({ line, failed.empty() ? std::string("malformed JSON object") : "bad value for " + failed });
+                    return;
+                }
+                SkipSpace(text, i);
+                if (i < text.size() && text[i] == ',') i++;
+                SkipSpace(text, i);
+                if (i < text.size() && text[i] == ']') i++;
+                if (i != text.size())
+                {
+                    errors.push_back({ line, "trailing characters after JSON object" });
+                    return;
+                }
+                out.push_back(std::move(record));
+            }
+        };
+
+        template <typename Record>
+        Result<Record> Load(const char* path, const std::vector<Field<Record>>& fields, unsigned threads, const Record& blank, bool csv)
+        {
+            Result<Record> result;
+            int fd = open(path, O_RDONLY);
+            if (fd < 0) return result;
+            struct stat st;
+            if (fstat(fd, &st) < 0)
+            {
+                close(fd);
+                return result;
+            }
+            result.opened = true;
+            const size_t size = static_cast<size_t>(st.st_size);
+            if (size == 0)
+            {
+                close(fd);
+                return result;
+            }
+            void* map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (map == MAP_FAILED)
+            {
+                result.opened = false;
+                return result;
+            }
+            const char* data = static_cast<const char*>(map);
+
+            /* CSV header: map every column to the field of the same name, or -1. */
+            size_t bodyStart = 0;
+            size_t bodyLine = 1;
+            std::vector<int> columnField;
+            if (csv)
+            {
+                bool inQuotes = false;
+                size_t headerEnd = size;
+                Classify(data, data + size, true, inQuotes, [&](size_t offset, uint64_t, uint64_t, uint64_t recordEnds) {
+                    if (!recordEnds) return true;
+                    headerEnd = offset + __builtin_ctzll(recordEnds);
+                    return false;
+                });
+                std::vector<std::string_view> names;
+                std::deque<std::string> scratch;
+                SplitCsv(TrimCr(std::string_view(data, headerEnd)), names, scratch);
+                for (std::string_view name : names)
+                {
+                    int match = -1;
+                    for (size_t f = 0; f < fields.size(); f++)
+                    {
+                        if (name == fields[f].name) match = static_cast<int>(f);
+                    }
+                    columnField.push_back(match);
+                }
+                bodyStart = std::min(size, headerEnd + 1);
+                bodyLine = 2;
+            }
+
+            if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+            const size_t body = size - bodyStart;
+            threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, body / (1 << 16) + 1)));
+
+            std::vector<Chunk<Record>> chunks(threads);
+            for (unsigned t = 0; t < threads; t++)
+            {
+                chunks[t].begin = bodyStart + body * t / threads;
+                chunks[t].end = bodyStart + body * (t + 1) / threads;
+            }
+
+            auto runAll = [&](auto work) {
+                std::vector<std::thread> workers;
+                for (unsigned t = 1; t < threads; t++) workers.emplace_back(work, t);
+                work(0);
+                for (auto& w : workers) w.join();
+            };
+
+            /* Pass 1: quote and newline counts per chunk. */
+            runAll([&](unsigned t) {
+                Chunk<Record>& chunk = chunks[t];
+                bool inQuotes = false;
+                Classify(data + chunk.begin, data + chunk.end, csv, inQuotes, [&](size_t, uint64_t newlines, uint64_t quotes, uint64_t) {
+                    chunk.newlines += __builtin_popcountll(newlines);
+                    chunk.quotes += __builtin_popcountll(quotes);
+                    return true;
+                });
+            });
+            chunks[0].firstLine = bodyLine;
+            for (unsigned t = 1; t < threads; t++)
+            {
+                chunks[t].firstLine = chunks[t - 1].firstLine + chunks[t - 1].newlines;
+                chunks[t].startsInQuotes = chunks[t - 1].startsInQuotes ^ (chunks[t - 1].quotes & 1);
+            }
+
+            /*
+             * Pass 2: a chunk owns every record that starts right after one of
+             * its record-ending newlines (chunk 0 also owns the record at its
+             * start). The last one it owns may run past its end, so scanning
+             * continues until that record is closed.
+             */
+            runAll([&](unsigned t) {
+                Chunk<Record>& chunk = chunks[t];
+                Parser<Record> parser(fields, blank, csv, columnField);
+                bool inQuotes = chunk.startsInQuotes;
+                size_t line = chunk.firstLine;
+                bool open = (t == 0);
+                size_t recordStart = chunk.begin;
+                size_t recordLine = line;
+                Classify(data + chunk.begin, data + size, csv, inQuotes, [&](size_t offset, uint64_t newlines, uint64_t, uint64_t recordEnds) {
+                    size_t base = chunk.begin + offset;
+                    if (base >= chunk.end && !open) return false;
+                    while (recordEnds)
+                    {
+                        int bit = __builtin_ctzll(recordEnds);
+                        size_t position = base + bit;
+                        size_t lineHere = line + __builtin_popcountll(newlines & ((uint64_t(2) << bit) - 1));
+                        if (open)
+                        {
+                            parser.Parse(std::string_view(data + recordStart, position - recordStart), recordLine, chunk.records, chunk.errors);
+                            open = false;
+                        }
+                        if (position >= chunk.end) return false;
+                        open = true;
+                        recordStart = position + 1;
+                        recordLine = lineHere;
+                        recordEnds &= recordEnds - 1;
+                    }
+                    line += __builtin_popcountll(newlines);
+                    return true;
+                });
+                if (open && recordStart < size)
+                {
+                    if (inQuotes)
+                    {
+                        chunk.errors.push_back({ recordLine, "unterminated quoted field" });
+                    }
+                    else
+                    {
+                        parser.Parse(std::string_view(data + recordStart, size - recordStart), recordLine, chunk.records, chunk.errors);
+                    }
+                }
+            });
+
+            for (Chunk<Record>& chunk : chunks)
+            {
+                result.records.insert(result.records.end(), std::make_move_iterator(chunk.records.begin()), std::make_move_iterator(chunk.records.end()));
+                result.errors.insert(result.errors.end(), chunk.errors.begin(), chunk.errors.end());
+            }
+            munmap(map, size);
+            return result;
+        }
+    }
+
+    template <typename Record>
+    Result<Record> LoadCsv(const char* path, const std::vector<Field<Record>>& fields, unsigned threads = 0, const Record& blank = Record())
+    {
+        return Detail::Load(path, fields, threads, blank, true);
+    }
+
+    template <typename Record>
+    Result<Record> LoadJsonLines(const char* path, const std::vector<Field<Record>>& fields, unsigned threads = 0, const Record& blank = Record())
+    {
+        return Detail::Load(path, fields, threads, blank, false);
+    }
+
+    /* Picks the format from the extension: .json / .jsonl, anything else is CSV. */
+    template <typename Record>
+    Result<Record> Load(const char* path, const std::vector<Field<Record>>& fields, unsigned threads = 0, const Record& blank = Record())
+    {
+        auto endsWith = [](std::string_view s, std::string_view suffix) {
+            return s.size() >= suffix.size() && s.substr(s.size() - suffix.size()) == suffix;
+        };
+        bool json = endsWith(path, ".json") || endsWith(path, ".jsonl");
+        return Detail::Load(path, fields, threads, blank, !json);
+    }
+}
+
+#endif // RECORD_LOADER_H
@@ -1,3 +1,14 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <chrono>
+#include <vector>
+#if defined(__SSSE3__) || defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
 #define SET_BIT(REG, BIT) (REG |= (1 << BIT))
 
 int covert(std::string &Binary)
@@ -17,26 +28,222 @@ int covert(std::string &Binary)
 }
 
 
-std::string covert(unsigned int n)
+/*
+ * Fixed-width binary text <-> integer conversion, most significant bit first
+ * ("00111111" is 63). Eight characters are handled per 64-bit word: pext/pdep
+ * with BMI2, otherwise a multiply that gathers or spreads the eight bits.
+ * Sixteen (SSSE3) or thirty-two (AVX2) characters are parsed at once by
+ * reversing the bytes with a shuffle and collecting them with compare +
+ * movemask. Nothing allocates; callers pass the buffers.
+ */
+namespace BitString
 {
-	unsigned int bit = 1 << 31;
-	std::string s;
-	while (bit)
+	const uint64_t lowBits = 0x0101010101010101ULL;
+	const uint64_t zeros = 0x3030303030303030ULL;
+
+	/* Eight '0'/'1' characters to a byte; false on any other character. */
+	inline bool parse8(const char* s, uint8_t& out)
+	{
+		uint64_t word;
+		std::memcpy(&word, s, 8);
+		if ((word & ~lowBits) != zeros)
+		{
+			return false;
+		}
+#if defined(__BMI2__)
+		out = static_cast<uint8_t>(_pext_u64(__builtin_bswap64(word), lowBits));
+#else
+		out = static_cast<uint8_t>(((word & lowBits) * 0x8040201008040201ULL) >> 56);
+#endif
+		return true;
+	}
+
+	/* A byte to eight '0'/'1' characters. */
+	inline void format8(uint8_t value, char* s)
+	{
+#if defined(__BMI2__)
+		uint64_t word = __builtin_bswap64(_pdep_u64(value, lowBits)) | zeros;
+#else
+		uint64_t spread = ((value * lowBits) & 0x8040201008040201ULL) + 0x7F7F7F7F7F7F7F7FULL;
+		uint64_t word = __builtin_bswap64((spread >> 7) & lowBits) | zeros;
+#endif
+		std::memcpy(s, &word, 8);
+	}
+
+#if defined(__SSSE3__)
+	inline bool parse16(const char* s, uint16_t& out)
+	{
+		const __m128i reverse = _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+		__m128i v = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)), reverse);
+		__m128i ones = _mm_cmpeq_epi8(v, _mm_set1_epi8('1'));
+		__m128i valid = _mm_or_si128(ones, _mm_cmpeq_epi8(v, _mm_set1_epi8('0')));
+		if (_mm_movemask_epi8(valid) != 0xFFFF)
+		{
+			return false;
+		}
+		out = static_cast<uint16_t>(_mm_movemask_epi8(ones));
+		return true;
+	}
+#endif
+
+#if defined(__AVX2__)
+	inline bool parse32(const char* s, uint32_t& out)
 	{
-		if ((n & bit) != 0)
+		const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+			15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+		__m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)), reverse);
+		v = _mm256_permute4x64_epi64(v, 0x4E);
+		__m256i ones = _mm256_cmpeq_epi8(v, _mm256_set1_epi8('1'));
+		__m256i valid = _mm256_or_si256(ones, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('0')));
+		if (static_cast<uint32_t>(_mm256_movemask_epi8(valid)) != 0xFFFFFFFFu)
 		{
-			s += "1";
+			return false;
 		}
-		else
+		out = static_cast<uint32_t>(_mm256_movemask_epi8(ones));
+		return true;
+	}
+#endif
+
+	/* Exactly 8 * sizeof(T) characters at s to a T (uint8_t ... uint64_t). */
+	template <typename T>
+	bool parse(const char* s, T& out)
+	{
+		const size_t width = 8 * sizeof(T);
+		uint64_t value = 0;
+		size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 32 <= width; i += 32)
+		{
+			uint32_t part;
+			if (!parse32(s + i, part)) return false;
+			value = (value << 16 << 16) | part;
+		}
+#endif
+#if defined(__SSSE3__)
+		for (; i + 16 <= width; i += 16)
+		{
+			uint16_t part;
+			if (!parse16(s + i, part)) return false;
+			value = (value << 16) | part;
+		}
+#endif
+		for (; i < width; i += 8)
+		{
+			uint8_t part;
+			if (!parse8(s + i, part)) return false;
+			value = (value << 8) | part;
+		}
+		out = static_cast<T>(value);
+		return true;
+	}
+
+	template <typename T>
+	bool parse(std::string_view s, T& out)
+	{
+		return s.size() == 8 * sizeof(T) && parse(s.data(), out);
+	}
+
+	/* Writes exactly 8 * sizeof(T) characters (no terminator) to s. */
+	template <typename T>
+	void format(T value, char* s)
+	{
+		for (size_t i = 0; i < sizeof(T); i++)
 		{
-			s += "0";
+			format8(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * (sizeof(T) - 1 - i))), s + 8 * i);
 		}
-		bit = bit >> 1;
 	}
+
+	/*
+	 * Parses count fixed-width records laid out stride bytes apart (e.g. one
+	 * value per line: stride = 8 * sizeof(T) + 1). Returns how many were
+	 * parsed; a smaller number is the index of the first invalid record.
+	 */
+	template <typename T>
+	size_t parse_batch(const char* text, size_t stride, T* out, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			if (!parse(text + i * stride, out[i]))
+			{
+				return i;
+			}
+		}
+		return count;
+	}
+
+	/* Formats count values stride bytes apart, filling any gap with separator. */
+	template <typename T>
+	void format_batch(const T* values, size_t count, char* out, size_t stride, char separator = '\n')
+	{
+		const size_t width = 8 * sizeof(T);
+		for (size_t i = 0; i < count; i++)
+		{
+			char* record = out + i * stride;
+			format(values[i], record);
+			if (stride > width)
+			{
+				std::memset(record + width, separator, stride - width);
+			}
+		}
+	}
+}
+
+
+std::string covert(unsigned int n)
+{
+	std::string s(32, '0');
+	BitString::format<uint32_t>(n, &s[0]);
 	return s;
 }
 
-int main() {
+
+/* Per-value covert() loops against the batch API on 32-bit values. */
+void benchmark(size_t count)
+{
+	std::vector<uint32_t> values(count);
+	for (size_t i = 0; i < count; i++)
+	{
+		values[i] = static_cast<uint32_t>(i * 2654435761u);
+	}
+	const size_t stride = 33;
+	std::vector<char> text(count * stride);
+	std::vector<uint32_t> parsed(count);
+
+	auto seconds = [](auto start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+	auto mbps = [&](double s) { return text.size() / s / 1e6; };
+
+	auto start = std::chrono::steady_clock::now();
+	BitString::format_batch(values.data(), count, text.data(), stride);
+	double formatBatch = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	size_t ok = BitString::parse_batch(text.data(), stride, parsed.data(), count);
+	double parseBatch = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	uint64_t check = 0;
+	for (size_t i = 0; i < count; i++)
+	{
+		std::string s(text.data() + i * stride, 32);
+		check += covert(s);
+	}
+	double parseOld = seconds(start);
+
+	std::cout << "format_batch: " << mbps(formatBatch) << " MB/s" << std::endl;
+	std::cout << "parse_batch:  " << mbps(parseBatch) << " MB/s (" << ok << " values)" << std::endl;
+	std::cout << "covert(s):    " << mbps(parseOld) << " MB/s (checksum " << check << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::strcmp(argv[1], "--bench") == 0)
+	{
+		benchmark(size_t(1) << 22);
+		return 0;
+	}
+
+
 	std::string s{ "00111111" };
 	std::cout << covert(s) << std::endl;
 
@@ -1,6 +1,31 @@
 
 #include <iostream>
+#include <iomanip>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <set>
+#include <thread>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <cstddef>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <limits>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../RecordLoader.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 struct Name {
     std::string firstName;
@@ -42,7 +67,1152 @@ struct Employee {
     Salary salary;
 };
 
-int main() {
+/* Strings stored back to back in one buffer, referred to by offset and length. */
+class StringArena
+{
+public:
+    /* size_t, so multi-GB loads do not wrap */
+    struct Ref
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    Ref add(std::string_view s)
+    {
+        Ref ref = { bytes.size(), s.size() };
+        bytes.insert(bytes.end(), s.begin(), s.end());
+        return ref;
+    }
+
+    std::string_view get(Ref ref) const
+    {
+        return std::string_view(bytes.data() + ref.offset, ref.length);
+    }
+
+private:
+    std::vector<char> bytes;
+};
+
+/* Money as fixed-point cents, so sums are exact. */
+inline int64_t toCents(double amount)
+{
+    return std::llround(amount * 100);
+}
+
+struct JobTotal
+{
+    std::string job;
+    size_t employees;
+    int64_t netPayCents;
+};
+
+/*
+ * Employees stored column by column: every field is its own array, strings
+ * live in one arena, the job is dictionary-encoded, and salary parts are
+ * int64 cents. Payroll scans touch only the four salary columns (and the job
+ * ids when grouping), 8 bytes per value, instead of whole Employee objects.
+ */
+class EmployeeTable
+{
+private:
+    StringArena strings;
+    std::vector<StringArena::Ref> firstName, middleName, lastName;
+    std::vector<StringArena::Ref> street, city, country;
+    std::vector<StringArena::Ref> telephoneNumber, mobileNumber, emailAddress;
+    std::vector<uint8_t> birthDay, birthMonth;
+    std::vector<int16_t> birthYear;
+    std::vector<uint32_t> jobId;
+    std::vector<std::string> jobNames;
+    std::unordered_map<std::string, uint32_t> jobIds;
+    std::vector<int64_t> basic, additional, reductions, taxes;
+
+    /* Net pay summed over rows [first, last): basic + additional - reductions - taxes. */
+    int64_t netPayRange(size_t first, size_t last) const
+    {
+        int64_t total = 0;
+        size_t i = first;
+#if defined(__AVX2__)
+        __m256i acc = _mm256_setzero_si256();
+        for (; i + 4 <= last; i += 4)
+        {
+            __m256i pay = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&basic[i])),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&additional[i])));
+            __m256i cut = _mm256_add_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(&reductions[i])),
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&taxes[i])));
+            acc = _mm256_add_epi64(acc, _mm256_sub_epi64(pay, cut));
+        }
+        alignas(32) int64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+        total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#endif
+        for (; i < last; i++)
+        {
+            total += basic[i] + additional[i] - reductions[i] - taxes[i];
+        }
+        return total;
+    }
+
+    /* Runs f(first, last, t) over threads contiguous row ranges. */
+    template <typename F>
+    void forRanges(unsigned threads, F f) const
+    {
+        const size_t rows = size();
+        threads = std::max(1u, std::min<unsigned>(threads, static_cast<unsigned>(rows / 4096 + 1)));
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; t++)
+        {
+            workers.emplace_back(f, rows * t / threads, rows * (t + 1) / threads, t);
+        }
+        f(0, rows / threads, 0u);
+        for (auto& w : workers)
+        {
+            w.join();
+        }
+    }
+
+public:
+    size_t add(const Employee& e)
+    {
+        firstName.push_back(strings.add(e.name.firstName));
+        middleName.push_back(strings.add(e.name.middleName));
+        lastName.push_back(strings.add(e.name.lastName));
+        street.push_back(strings.add(e.address.street));
+        city.push_back(strings.add(e.address.city));
+        country.push_back(strings.add(e.address.country));
+        telephoneNumber.push_back(strings.add(e.contacts.telephoneNumber));
+        mobileNumber.push_back(strings.add(e.contacts.mobileNumber));
+        emailAddress.push_back(strings.add(e.contacts.emailAddress));
+        birthDay.push_back(static_cast<uint8_t>(e.dateOfBirth.day));
+        birthMonth.push_back(static_cast<uint8_t>(e.dateOfBirth.month));
+        birthYear.push_back(static_cast<int16_t>(e.dateOfBirth.year));
+
+        auto job = jobIds.emplace(e.job, static_cast<uint32_t>(jobNames.size()));
+        if (job.second)
+        {
+            jobNames.push_back(e.job);
+        }
+        jobId.push_back(job.first->second);
+
+        basic.push_back(toCents(e.salary.basic));
+        additional.push_back(toCents(e.salary.additional));
+        reductions.push_back(toCents(e.salary.reductions));
+        taxes.push_back(toCents(e.salary.taxes));
+        return basic.size() - 1;
+    }
+
+    /* Rebuilds row i as an Employee. */
+    Employee get(size_t i) const
+    {
+        auto str = [this](StringArena::Ref ref) { return std::string(strings.get(ref)); };
+        return Employee{
+            { str(firstName[i]), str(middleName[i]), str(lastName[i]) },
+            { birthDay[i], birthMonth[i], birthYear[i] },
+            { str(street[i]), str(city[i]), str(country[i]) },
+            { str(telephoneNumber[i]), str(mobileNumber[i]), str(emailAddress[i]) },
+            jobNames[jobId[i]],
+            { basic[i] / 100.0, additional[i] / 100.0, reductions[i] / 100.0, taxes[i] / 100.0 }
+        };
+    }
+
+    size_t size() const
+    {
+        return basic.size();
+    }
+
+    int64_t netPayCents(size_t i) const
+    {
+        return basic[i] + additional[i] - reductions[i] - taxes[i];
+    }
+
+    int64_t totalNetPayCents(unsigned threads = std::thread::hardware_concurrency()) const
+    {
+        std::vector<int64_t> partial(std::max(1u, threads), 0);
+        forRanges(threads, [&](size_t first, size_t last, unsigned t) { partial[t] = netPayRange(first, last); });
+        int64_t total = 0;
+        for (int64_t p : partial) total += p;
+        return total;
+    }
+
+    /* Head count and net pay per job, each thread grouping its own rows. */
+    std::vector<JobTotal> netPayByJob(unsigned threads = std::thread::hardware_concurrency()) const
+    {
+        threads = std::max(1u, threads);
+        std::vector<std::vector<int64_t>> pay(threads, std::vector<int64_t>(jobNames.size(), 0));
+        std::vector<std::vector<size_t>> heads(threads, std::vector<size_t>(jobNames.size(), 0));
+        forRanges(threads, [&](size_t first, size_t last, unsigned t) {
+            for (size_t i = first; i < last; i++)
+            {
+                pay[t][jobId[i]] += basic[i] + additional[i] - reductions[i] - taxes[i];
+                heads[t][jobId[i]]++;
+            }
+        });
+
+        std::vector<JobTotal> totals;
+        for (size_t j = 0; j < jobNames.size(); j++)
+        {
+            JobTotal total = { jobNames[j], 0, 0 };
+            for (unsigned t = 0; t < threads; t++)
+            {
+                total.employees += heads[t][j];
+                total.netPayCents += pay[t][j];
+            }
+            totals.push_back(total);
+        }
+        return totals;
+    }
+};
+
+std::string formatCents(int64_t cents)
+{
+    std::string sign = cents < 0 ? "-" : "";
+    int64_t magnitude = cents < 0 ? -cents : cents;
+    std::string fraction = std::to_string(magnitude % 100);
+    return sign + std::to_string(magnitude / 100) + "." + (fraction.size() < 2 ? "0" : "") + fraction;
+}
+
+
+/*
+ * On-disk Employee records that are read in place from a mapping:
+ *
+ *   FileHeader | recordCount fixed-size records | string heap
+ *
+ * Every record has the same size and each scalar sits at a fixed offset.
+ * Strings are (offset, length) pairs into the heap, which starts at
+ * heapOffset. Schema evolution: new fields are only ever appended to the
+ * record and recordSize is stored in the header. A reader uses a field only if
+ * recordSize covers it (older files give the field's default), and it skips
+ * trailing bytes it does not know about. A layout change that cannot be done
+ * by appending bumps versionMajor, which readers refuse.
+ */
+namespace EmployeeFile
+{
+    const char magic[8] = { 'E', 'M', 'P', 'R', 'E', 'C', '\0', '\0' };
+    const uint16_t versionMajor = 2;
+    const uint16_t versionMinor = 0;
+
+    struct FileHeader
+    {
+        char magic[8];
+        uint16_t versionMajor;
+        uint16_t versionMinor;
+        uint32_t recordSize;
+        uint64_t recordCount;
+        uint64_t recordsOffset;
+        uint64_t heapOffset;
+        uint64_t heapSize;
+    };
+
+    /* 2.0 widened the offset from 32 bits: 1.x heaps wrapped at 4 GiB */
+    struct StringRef
+    {
+        uint64_t offset;
+        uint32_t length;
+        uint32_t reserved;
+    };
+
+    /* Record layout, version 2.0. Append new fields at the end only. */
+    struct Record
+    {
+        StringRef firstName, middleName, lastName;
+        StringRef street, city, country;
+        StringRef telephoneNumber, mobileNumber, emailAddress;
+        StringRef job;
+        int64_t basicCents;
+        int64_t additionalCents;
+        int64_t reductionsCents;
+        int64_t taxesCents;
+        int16_t birthYear;
+        uint8_t birthDay;
+        uint8_t birthMonth;
+        uint8_t reserved[4];
+    };
+
+    static_assert(sizeof(Record) % 8 == 0, "records must keep 8-byte alignment");
+
+    /* Read-only accessor for one mapped record; nothing is copied or parsed. */
+    class View
+    {
+    private:
+        const char* record;
+        const char* heap;
+        uint64_t heapSize;
+        uint32_t recordSize;
+
+        template <typename T>
+        T scalar(size_t offset, T fallback = T()) const
+        {
+            if (offset + sizeof(T) > recordSize) return fallback;
+            T value;
+            std::memcpy(&value, record + offset, sizeof(T));
+            return value;
+        }
+
+        /* A ref that points outside the heap reads as an empty string */
+        std::string_view string(size_t offset) const
+        {
+            StringRef ref = scalar<StringRef>(offset, StringRef{ 0, 0, 0 });
+            if (ref.offset > heapSize || ref.length > heapSize - ref.offset) return std::string_view();
+            return std::string_view(heap + ref.offset, ref.length);
+        }
+
+    public:
+        View(const char* record, const char* heap, uint64_t heapSize, uint32_t recordSize)
+            : record(record), heap(heap), heapSize(heapSize), recordSize(recordSize)
+        {
+        }
+
+        std::string_view firstName() const { return string(offsetof(Record, firstName)); }
+        std::string_view middleName() const { return string(offsetof(Record, middleName)); }
+        std::string_view lastName() const { return string(offsetof(Record, lastName)); }
+        std::string_view street() const { return string(offsetof(Record, street)); }
+        std::string_view city() const { return string(offsetof(Record, city)); }
+        std::string_view country() const { return string(offsetof(Record, country)); }
+        std::string_view telephoneNumber() const { return string(offsetof(Record, telephoneNumber)); }
+        std::string_view mobileNumber() const { return string(offsetof(Record, mobileNumber)); }
+        std::string_view emailAddress() const { return string(offsetof(Record, emailAddress)); }
+        std::string_view job() const { return string(offsetof(Record, job)); }
+        int64_t basicCents() const { return scalar<int64_t>(offsetof(Record, basicCents)); }
+        int64_t additionalCents() const { return scalar<int64_t>(offsetof(Record, additionalCents)); }
+        int64_t reductionsCents() const { return scalar<int64_t>(offsetof(Record, reductionsCents)); }
+        int64_t taxesCents() const { return scalar<int64_t>(offsetof(Record, taxesCents)); }
+        int birthDay() const { return scalar<uint8_t>(offsetof(Record, birthDay)); }
+        int birthMonth() const { return scalar<uint8_t>(offsetof(Record, birthMonth)); }
+        int birthYear() const { return scalar<int16_t>(offsetof(Record, birthYear)); }
+
+        int64_t netPayCents() const
+        {
+            return basicCents() + additionalCents() - reductionsCents() - taxesCents();
+        }
+
+        Employee toEmployee() const
+        {
+            auto str = [](std::string_view v) { return std::string(v); };
+            return Employee{
+                { str(firstName()), str(middleName()), str(lastName()) },
+                { birthDay(), birthMonth(), birthYear() },
+                { str(street()), str(city()), str(country()) },
+                { str(telephoneNumber()), str(mobileNumber()), str(emailAddress()) },
+                str(job()),
+                { basicCents() / 100.0, additionalCents() / 100.0, reductionsCents() / 100.0, taxesCents() / 100.0 }
+            };
+        }
+    };
+
+    /*
+     * Streams records to path. The string heap goes to a side file while
+     * writing and is appended behind the records on close, so memory use does
+     * not depend on the record count.
+     */
+    class Writer
+    {
+    private:
+        std::string path;
+        std::ofstream records;
+        std::ofstream heap;
+        FileHeader header;
+        bool tooLong;
+
+        StringRef add(const std::string& s)
+        {
+            if (s.size() > UINT32_MAX)
+            {
+                tooLong = true;
+                return StringRef{ 0, 0, 0 };
+            }
+            StringRef ref = { header.heapSize, static_cast<uint32_t>(s.size()), 0 };
+            heap.write(s.data(), s.size());
+            header.heapSize += s.size();
+            return ref;
+        }
+
+    public:
+        explicit Writer(const std::string& path)
+            : path(path), records(path, std::ios::binary | std::ios::trunc), heap(path + ".heap", std::ios::binary | std::ios::trunc), tooLong(false)
+        {
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.versionMajor = versionMajor;
+            header.versionMinor = versionMinor;
+            header.recordSize = sizeof(Record);
+            header.recordCount = 0;
+            header.recordsOffset = sizeof(FileHeader);
+            header.heapOffset = 0;
+            header.heapSize = 0;
+            records.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+
+        bool is_open() const
+        {
+            return records.is_open() && heap.is_open();
+        }
+
+        void add(const Employee& e)
+        {
+            Record r = {};
+            r.firstName = add(e.name.firstName);
+            r.middleName = add(e.name.middleName);
+            r.lastName = add(e.name.lastName);
+            r.street = add(e.address.street);
+            r.city = add(e.address.city);
+            r.country = add(e.address.country);
+            r.telephoneNumber = add(e.contacts.telephoneNumber);
+            r.mobileNumber = add(e.contacts.mobileNumber);
+            r.emailAddress = add(e.contacts.emailAddress);
+            r.job = add(e.job);
+            r.basicCents = toCents(e.salary.basic);
+            r.additionalCents = toCents(e.salary.additional);
+            r.reductionsCents = toCents(e.salary.reductions);
+            r.taxesCents = toCents(e.salary.taxes);
+            r.birthYear = static_cast<int16_t>(e.dateOfBirth.year);
+            r.birthDay = static_cast<uint8_t>(e.dateOfBirth.day);
+            r.birthMonth = static_cast<uint8_t>(e.dateOfBirth.month);
+            records.write(reinterpret_cast<const char*>(&r), sizeof(r));
+            header.recordCount++;
+        }
+
+        /* False if writing failed or a string was over 4 GiB (stored as empty) */
+        bool close()
+        {
+            heap.close();
+            header.heapOffset = header.recordsOffset + header.recordCount * sizeof(Record);
+            /* operator<< sets failbit when it copies nothing, so an empty heap is skipped */
+            if (header.heapSize > 0)
+            {
+                std::ifstream heapIn(path + ".heap", std::ios::binary);
+                records << heapIn.rdbuf();
+                if (static_cast<uint64_t>(records.tellp()) != header.heapOffset + header.heapSize) records.setstate(std::ios::failbit);
+            }
+            std::remove((path + ".heap").c_str());
+
+            records.seekp(0);
+            records.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            records.close();
+            return !records.fail() && !tooLong;
+        }
+    };
+
+    /* A mapped record file; opening checks the header and bounds, nothing else. */
+    class Reader
+    {
+    private:
+        const char* data;
+        size_t length;
+        FileHeader header;
+
+    public:
+        explicit Reader(const char* path) : data(nullptr), length(0), header()
+        {
+            int fd = open(path, O_RDONLY);
+            struct stat st;
+            if (fd < 0) return;
+            if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= sizeof(FileHeader))
+            {
+                void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (map != MAP_FAILED)
+                {
+                    data = static_cast<const char*>(map);
+                    length = st.st_size;
+                }
+            }
+            close(fd);
+            if (!data) return;
+
+            std::memcpy(&header, data, sizeof(header));
+            bool valid = std::memcmp(header.magic, magic, sizeof(magic)) == 0
+                && header.versionMajor == versionMajor
+                && header.recordSize >= 8 && header.recordSize % 8 == 0
+                && header.recordsOffset >= sizeof(FileHeader)
+                && header.recordsOffset <= header.heapOffset && header.heapOffset <= length
+                && header.heapSize <= length - header.heapOffset
+                && header.recordCount <= (header.heapOffset - header.recordsOffset) / header.recordSize;
+            if (!valid)
+            {
+                munmap(const_cast<char*>(data), length);
+                data = nullptr;
+            }
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        ~Reader()
+        {
+            if (data) munmap(const_cast<char*>(data), length);
+        }
+
+        bool is_open() const
+        {
+            return data != nullptr;
+        }
+
+        size_t size() const
+        {
+            return header.recordCount;
+        }
+
+        View operator[](size_t i) const
+        {
+            return View(data + header.recordsOffset + i * header.recordSize, data + header.heapOffset, header.heapSize, header.recordSize);
+        }
+    };
+
+    /*
+     * Writes count synthetic records to path, evicts the file from the page
+     * cache, then times opening it, the first record, random lookups and a
+     * full net-pay scan.
+     */
+    void benchmark(const char* path, size_t count)
+    {
+        auto seconds = [](auto start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        if (count == 0)
+        {
+            std::cout << "Nothing to write!" << std::endl;
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            Writer writer(path);
+            Employee e = { {"Mina", "Magdy", "Aziz"}, {26, 7, 1998}, {"26", "Shoubra", "Cairo"},
+                {"01203591115", "01203591115", "mina@gmail.com"}, "Software Engineer", {50000.0, 5000.0, 2000.0, 10000.0} };
+            for (size_t i = 0; i < count; i++)
+            {
+                e.contacts.emailAddress = "employee" + std::to_string(i) + "@gmail.com";
+                e.salary.basic = 30000.0 + i % 20000;
+                writer.add(e);
+            }
+            if (!writer.close())
+            {
+                std::cout << "Error writing file!" << std::endl;
+                return;
+            }
+        }
+        double write = seconds(start);
+
+        int fd = open(path, O_RDONLY);
+        if (fd >= 0)
+        {
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+
+        start = std::chrono::steady_clock::now();
+        Reader reader(path);
+        if (!reader.is_open())
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return;
+        }
+        std::string_view first = reader[0].emailAddress();
+        double openFirst = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        size_t lookups = 1000000;
+        uint64_t position = 88172645463325252ULL;
+        int64_t check = 0;
+        for (size_t i = 0; i < lookups; i++)
+        {
+            position ^= position << 13;
+            position ^= position >> 7;
+            position ^= position << 17;
+            check += reader[position % reader.size()].basicCents();
+        }
+        double random = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        int64_t total = 0;
+        for (size_t i = 0; i < reader.size(); i++)
+        {
+            total += reader[i].netPayCents();
+        }
+        double scan = seconds(start);
+
+        std::cout << reader.size() << " records, first " << first << " (checksum " << check << ")" << std::endl;
+        std::cout << "write:                " << write << " s" << std::endl;
+        std::cout << "cold open + record 0: " << openFirst * 1e3 << " ms" << std::endl;
+        std::cout << lookups << " random lookups: " << random << " s" << std::endl;
+        std::cout << "net pay scan:         " << scan << " s (" << formatCents(total) << ")" << std::endl;
+    }
+}
+
+
+/*
+ * Secondary indexes over an Employee collection. Rows are addressed by a
+ * stable RowId; erased slots are reused by later inserts.
+ *
+ * HashIndex maps a string key (email, mobile number) to its rows in O(1).
+ * RangeIndex keeps (key, row) pairs sorted for O(log n) point and range
+ * lookups. The bulk of them sit in a flat sorted array; recent inserts and
+ * erases go to two small ordered sets. Once those hold about n/16 entries
+ * they are merged into the array in one linear pass. Scans walk the array and
+ * the insert set together in key order and skip erased entries.
+ */
+namespace EmployeeIndex
+{
+    using RowId = uint32_t;
+
+    class HashIndex
+    {
+    private:
+        std::unordered_multimap<std::string, RowId> rows;
+
+    public:
+        void build(const std::vector<std::pair<std::string_view, RowId>>& entries)
+        {
+            rows.clear();
+            rows.reserve(entries.size());
+            for (const auto& entry : entries)
+            {
+                rows.emplace(std::string(entry.first), entry.second);
+            }
+        }
+
+        void insert(std::string_view key, RowId row)
+        {
+            rows.emplace(std::string(key), row);
+        }
+
+        void erase(std::string_view key, RowId row)
+        {
+            auto range = rows.equal_range(std::string(key));
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (it->second == row)
+                {
+                    rows.erase(it);
+                    return;
+                }
+            }
+        }
+
+        size_t count(std::string_view key) const
+        {
+            return rows.count(std::string(key));
+        }
+
+        template <typename F>
+        void forEach(std::string_view key, F f) const
+        {
+            auto range = rows.equal_range(std::string(key));
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                f(it->second);
+            }
+        }
+    };
+
+    template <typename Key>
+    class RangeIndex
+    {
+    public:
+        using Entry = std::pair<Key, RowId>;
+
+    private:
+        std::vector<Entry> base;
+        std::set<Entry> delta, erased;
+
+        size_t mergeThreshold() const
+        {
+            return std::max<size_t>(4096, base.size() / 16);
+        }
+
+        /* Calls f(entry) for entries with lo <= key <= hi, in (key, row) order. */
+        template <typename F>
+        void scan(Key lo, Key hi, F f) const
+        {
+            const Entry first = { lo, 0 };
+            auto b = std::lower_bound(base.begin(), base.end(), first);
+            auto d = delta.lower_bound(first);
+            auto e = erased.lower_bound(first);
+            while (true)
+            {
+                bool haveBase = b != base.end() && b->first <= hi;
+                bool haveDelta = d != delta.end() && d->first <= hi;
+                if (!haveBase && !haveDelta)
+                {
+                    return;
+                }
+                const Entry& next = (haveBase && (!haveDelta || *b < *d)) ? *b++ : *d++;
+                while (e != erased.end() && *e < next) ++e;
+                if (e != erased.end() && *e == next)
+                {
+                    ++e;
+                    continue;
+                }
+                f(next);
+            }
+        }
+
+        void merge()
+        {
+            std::vector<Entry> merged;
+            merged.reserve(base.size() + delta.size());
+            std::merge(base.begin(), base.end(), delta.begin(), delta.end(), std::back_inserter(merged));
+            if (!erased.empty())
+            {
+                auto e = erased.cbegin();
+                merged.erase(std::remove_if(merged.begin(), merged.end(), [&](const Entry& entry) {
+                    while (e != erased.end() && *e < entry) ++e;
+                    return e != erased.end() && *e == entry;
+                }), merged.end());
+            }
+            base.swap(merged);
+            delta.clear();
+            erased.clear();
+        }
+
+    public:
+        void build(std::vector<Entry> entries)
+        {
+            std::sort(entries.begin(), entries.end());
+            base.swap(entries);
+            delta.clear();
+            erased.clear();
+        }
+
+        void insert(Key key, RowId row)
+        {
+            const Entry entry = { key, row };
+            if (erased.erase(entry) == 0)
+            {
+                delta.insert(entry);
+            }
+            if (delta.size() + erased.size() > mergeThreshold()) merge();
+        }
+
+        void erase(Key key, RowId row)
+        {
+            const Entry entry = { key, row };
+            if (delta.erase(entry) == 0)
+            {
+                erased.insert(entry);
+            }
+            if (delta.size() + erased.size() > mergeThreshold()) merge();
+        }
+
+        /* Upper bound on the matches in [lo, hi], from binary searches only. */
+        size_t estimate(Key lo, Key hi) const
+        {
+            auto first = std::lower_bound(base.begin(), base.end(), Entry{ lo, 0 });
+            auto last = std::upper_bound(first, base.end(), Entry{ hi, std::numeric_limits<RowId>::max() });
+            return static_cast<size_t>(last - first) + delta.size();
+        }
+
+        template <typename F>
+        void forRange(Key lo, Key hi, F f) const
+        {
+            scan(lo, hi, [&](const Entry& entry) { f(entry.second); });
+        }
+    };
+
+    inline int32_t birthKey(const DateOfBirth& date)
+    {
+        return date.year * 10000 + date.month * 100 + date.day;
+    }
+
+    class Directory;
+
+    /*
+     * Conjunction of predicates. run() evaluates the most selective one
+     * through its index, then for each remaining predicate either intersects
+     * with that index's (sorted) rows or, when the index would return far more
+     * rows than are left, checks the remaining rows directly.
+     */
+    class Query
+    {
+    private:
+        enum class Kind { Email, Mobile, Birth, Basic };
+
+        struct Predicate
+        {
+            Kind kind;
+            std::string text;
+            int64_t lo, hi;
+        };
+
+        const Directory& directory;
+        std::vector<Predicate> predicates;
+
+        size_t estimate(const Predicate& p) const;
+        std::vector<RowId> rows(const Predicate& p) const;
+        bool matches(const Predicate& p, const Employee& e) const;
+
+    public:
+        explicit Query(const Directory& directory) : directory(directory) {}
+
+        Query& emailIs(std::string_view email)
+        {
+            predicates.push_back({ Kind::Email, std::string(email), 0, 0 });
+            return *this;
+        }
+
+        Query& mobileIs(std::string_view mobile)
+        {
+            predicates.push_back({ Kind::Mobile, std::string(mobile), 0, 0 });
+            return *this;
+        }
+
+        Query& bornBetween(const DateOfBirth& from, const DateOfBirth& to)
+        {
+            predicates.push_back({ Kind::Birth, "", birthKey(from), birthKey(to) });
+            return *this;
+        }
+
+        Query& basicBetween(double lo, double hi)
+        {
+            predicates.push_back({ Kind::Basic, "", toCents(lo), toCents(hi) });
+            return *this;
+        }
+
+        /* Matching rows in ascending RowId order. */
+        std::vector<RowId> run() const;
+    };
+
+    /* Employees plus their email, mobile, birth date and basic salary indexes. */
+    class Directory
+    {
+    private:
+        std::vector<Employee> employees;
+        std::vector<uint8_t> live;
+        std::vector<RowId> freeRows;
+        size_t liveCount = 0;
+
+        friend class Query;
+        HashIndex byEmail, byMobile;
+        RangeIndex<int32_t> byBirth;
+        RangeIndex<int64_t> byBasic;
+
+    public:
+        RowId insert(const Employee& e)
+        {
+            RowId row;
+            if (!freeRows.empty())
+            {
+                row = freeRows.back();
+                freeRows.pop_back();
+                employees[row] = e;
+                live[row] = 1;
+            }
+            else
+            {
+                row = static_cast<RowId>(employees.size());
+                employees.push_back(e);
+                live.push_back(1);
+            }
+            liveCount++;
+            byEmail.insert(e.contacts.emailAddress, row);
+            byMobile.insert(e.contacts.mobileNumber, row);
+            byBirth.insert(birthKey(e.dateOfBirth), row);
+            byBasic.insert(toCents(e.salary.basic), row);
+            return row;
+        }
+
+        bool erase(RowId row)
+        {
+            if (!contains(row)) return false;
+            const Employee& e = employees[row];
+            byEmail.erase(e.contacts.emailAddress, row);
+            byMobile.erase(e.contacts.mobileNumber, row);
+            byBirth.erase(birthKey(e.dateOfBirth), row);
+            byBasic.erase(toCents(e.salary.basic), row);
+            live[row] = 0;
+            freeRows.push_back(row);
+            liveCount--;
+            return true;
+        }
+
+        /* Replaces the contents and builds the four indexes in parallel. */
+        void build(std::vector<Employee> all)
+        {
+            employees.swap(all);
+            live.assign(employees.size(), 1);
+            freeRows.clear();
+            liveCount = employees.size();
+
+            auto strings = [this](auto field) {
+                std::vector<std::pair<std::string_view, RowId>> entries(employees.size());
+                for (size_t i = 0; i < employees.size(); i++) entries[i] = { field(employees[i]), static_cast<RowId>(i) };
+                return entries;
+            };
+            auto keys = [this](auto field) {
+                std::vector<std::pair<decltype(field(employees[0])), RowId>> entries(employees.size());
+                for (size_t i = 0; i < employees.size(); i++) entries[i] = { field(employees[i]), static_cast<RowId>(i) };
+                return entries;
+            };
+            std::thread email([&] { byEmail.build(strings([](const Employee& e) { return std::string_view(e.contacts.emailAddress); })); });
+            std::thread mobile([&] { byMobile.build(strings([](const Employee& e) { return std::string_view(e.contacts.mobileNumber); })); });
+            std::thread birth([&] { byBirth.build(keys([](const Employee& e) { return birthKey(e.dateOfBirth); })); });
+            byBasic.build(keys([](const Employee& e) { return toCents(e.salary.basic); }));
+            email.join();
+            mobile.join();
+            birth.join();
+        }
+
+        bool contains(RowId row) const
+        {
+            return row < live.size() && live[row];
+        }
+
+        const Employee& operator[](RowId row) const
+        {
+            return employees[row];
+        }
+
+        size_t size() const
+        {
+            return liveCount;
+        }
+
+        Query query() const
+        {
+            return Query(*this);
+        }
+    };
+
+    inline size_t Query::estimate(const Predicate& p) const
+    {
+        switch (p.kind)
+        {
+        case Kind::Email: return directory.byEmail.count(p.text);
+        case Kind::Mobile: return directory.byMobile.count(p.text);
+        case Kind::Birth: return directory.byBirth.estimate(static_cast<int32_t>(p.lo), static_cast<int32_t>(p.hi));
+        default: return directory.byBasic.estimate(p.lo, p.hi);
+        }
+    }
+
+    inline std::vector<RowId> Query::rows(const Predicate& p) const
+    {
+        std::vector<RowId> out;
+        auto add = [&](RowId row) { out.push_back(row); };
+        switch (p.kind)
+        {
+        case Kind::Email: directory.byEmail.forEach(p.text, add); break;
+        case Kind::Mobile: directory.byMobile.forEach(p.text, add); break;
+        case Kind::Birth: directory.byBirth.forRange(static_cast<int32_t>(p.lo), static_cast<int32_t>(p.hi), add); break;
+        default: directory.byBasic.forRange(p.lo, p.hi, add); break;
+        }
+        std::sort(out.begin(), out.end());
+        return out;
+    }
+
+    inline bool Query::matches(const Predicate& p, const Employee& e) const
+    {
+        switch (p.kind)
+        {
+        case Kind::Email: return e.contacts.emailAddress == p.text;
+        case Kind::Mobile: return e.contacts.mobileNumber == p.text;
+        case Kind::Birth: { int64_t key = birthKey(e.dateOfBirth); return key >= p.lo && key <= p.hi; }
+        default: { int64_t key = toCents(e.salary.basic); return key >= p.lo && key <= p.hi; }
+        }
+    }
+
+    inline std::vector<RowId> Query::run() const
+    {
+        if (predicates.empty())
+        {
+            std::vector<RowId> all;
+            for (RowId row = 0; row < directory.live.size(); row++)
+            {
+                if (directory.live[row]) all.push_back(row);
+            }
+            return all;
+        }
+
+        std::vector<std::pair<size_t, const Predicate*>> order;
+        for (const Predicate& p : predicates)
+        {
+            order.push_back({ estimate(p), &p });
+        }
+        std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<RowId> result = rows(*order[0].second);
+        for (size_t i = 1; i < order.size() && !result.empty(); i++)
+        {
+            const Predicate& p = *order[i].second;
+            if (order[i].first > 8 * result.size())
+            {
+                result.erase(std::remove_if(result.begin(), result.end(),
+                    [&](RowId row) { return !matches(p, directory[row]); }), result.end());
+            }
+            else
+            {
+                std::vector<RowId> other = rows(p);
+                std::vector<RowId> both;
+                std::set_intersection(result.begin(), result.end(), other.begin(), other.end(), std::back_inserter(both));
+                result.swap(both);
+            }
+        }
+        return result;
+    }
+
+    /* Index lookups against linear scans over count generated employees. */
+    void benchmark(size_t count)
+    {
+        auto seconds = [](auto start) {
+            return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        };
+        if (count == 0)
+        {
+            std::cout << "Nothing to index!" << std::endl;
+            return;
+        }
+
+        std::vector<Employee> all(count);
+        uint64_t state = 88172645463325252ULL;
+        auto next = [&state]() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        };
+        for (size_t i = 0; i < count; i++)
+        {
+            Employee& e = all[i];
+            e.name = { "Mina", "Magdy", "Aziz" };
+            e.dateOfBirth = { static_cast<int>(next() % 28 + 1), static_cast<int>(next() % 12 + 1), static_cast<int>(1960 + next() % 45) };
+            e.contacts = { "0223456789", "010" + std::to_string(10000000 + i), "employee" + std::to_string(i) + "@gmail.com" };
+            e.job = "Software Engineer";
+            e.salary = { 20000.0 + next() % 80000, 5000.0, 2000.0, 10000.0 };
+        }
+        std::vector<Employee> copy = all;
+
+        auto start = std::chrono::steady_clock::now();
+        Directory directory;
+        directory.build(std::move(all));
+        double build = seconds(start);
+
+        const size_t lookups = 100000;
+        start = std::chrono::steady_clock::now();
+        size_t found = 0;
+        for (size_t i = 0; i < lookups; i++)
+        {
+            found += directory.query().emailIs("employee" + std::to_string(next() % count) + "@gmail.com").run().size();
+        }
+        double indexed = seconds(start);
+
+        const size_t scans = 20;
+        start = std::chrono::steady_clock::now();
+        size_t scanned = 0;
+        for (size_t i = 0; i < scans; i++)
+        {
+            std::string email = "employee" + std::to_string(next() % count) + "@gmail.com";
+            for (const Employee& e : copy)
+            {
+                if (e.contacts.emailAddress == email)
+                {
+                    scanned++;
+                    break;
+                }
+            }
+        }
+        double linear = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        std::vector<RowId> both = directory.query().bornBetween({ 1, 1, 1990 }, { 31, 12, 1990 }).basicBetween(50000.0, 50999.0).run();
+        double intersect = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        const size_t changes = 100000;
+        for (size_t i = 0; i < changes; i++)
+        {
+            RowId row = static_cast<RowId>(next() % count);
+            if (directory.contains(row))
+            {
+                Employee e = directory[row];
+                directory.erase(row);
+                e.salary.basic += 1000.0;
+                directory.insert(e);
+            }
+        }
+        double churn = seconds(start);
+
+        std::cout << count << " employees, index build " << build << " s" << std::endl;
+        std::cout << "email lookup: " << indexed / lookups * 1e9 << " ns indexed, "
+            << linear / scans * 1e9 << " ns linear (" << found << "/" << lookups << ", " << scanned << "/" << scans << " found)" << std::endl;
+        std::cout << "born 1990 and basic 50000-50999: " << both.size() << " rows in " << intersect * 1e6 << " us" << std::endl;
+        std::cout << "erase + insert: " << churn / changes * 1e9 << " ns per update" << std::endl;
+    }
+}
+
+/* Column / JSON key names understood by the CSV and JSON Lines loaders. */
+namespace EmployeeImport
+{
+    using RecordLoader::Field;
+
+    const std::vector<Field<Employee>>& fields()
+    {
+        static const std::vector<Field<Employee>> table = {
+            { "name.firstName", [](Employee& e, std::string_view v) { e.name.firstName = v; return true; } },
+            { "name.middleName", [](Employee& e, std::string_view v) { e.name.middleName = v; return true; } },
+            { "name.lastName", [](Employee& e, std::string_view v) { e.name.lastName = v; return true; } },
+            { "dateOfBirth.day", [](Employee& e, std::string_view v) { return RecordLoader::ParseInt(v, e.dateOfBirth.day) && e.dateOfBirth.day >= 1 && e.dateOfBirth.day <= 31; } },
+            { "dateOfBirth.month", [](Employee& e, std::string_view v) { return RecordLoader::ParseInt(v, e.dateOfBirth.month) && e.dateOfBirth.month >= 1 && e.dateOfBirth.month <= 12; } },
+            { "dateOfBirth.year", [](Employee& e, std::string_view v) { return RecordLoader::ParseInt(v, e.dateOfBirth.year); } },
+            { "address.street", [](Employee& e, std::string_view v) { e.address.street = v; return true; } },
+            { "address.city", [](Employee& e, std::string_view v) { e.address.city = v; return true; } },
+            { "address.country", [](Employee& e, std::string_view v) { e.address.country = v; return true; } },
+            { "contacts.telephoneNumber", [](Employee& e, std::string_view v) { e.contacts.telephoneNumber = v; return true; } },
+            { "contacts.mobileNumber", [](Employee& e, std::string_view v) { e.contacts.mobileNumber = v; return true; } },
+            { "contacts.emailAddress", [](Employee& e, std::string_view v) { e.contacts.emailAddress = v; return true; } },
+            { "job", [](Employee& e, std::string_view v) { e.job = v; return true; } },
+            { "salary.basic", [](Employee& e, std::string_view v) { return RecordLoader::ParseDouble(v, e.salary.basic); } },
+            { "salary.additional", [](Employee& e, std::string_view v) { return RecordLoader::ParseDouble(v, e.salary.additional); } },
+            { "salary.reductions", [](Employee& e, std::string_view v) { return RecordLoader::ParseDouble(v, e.salary.reductions); } },
+            { "salary.taxes", [](Employee& e, std::string_view v) { return RecordLoader::ParseDouble(v, e.salary.taxes); } },
+        };
+        return table;
+    }
+
+    /* Loads a .csv or .json/.jsonl export into a table and prints the payroll summary. */
+    int load(const char* path, unsigned threads)
+    {
+        auto start = std::chrono::steady_clock::now();
+        RecordLoader::Result<Employee> result = RecordLoader::Load(path, fields(), threads, Employee());
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (!result.opened)
+        {
+            std::cout << "Error opening file!" << std::endl;
+            return 1;
+        }
+        for (const RecordLoader::LoadError& error : result.errors)
+        {
+            std::cerr << path << ":" << error.line << ": " << error.message << std::endl;
+        }
+
+        EmployeeTable table;
+        for (const Employee& employee : result.records)
+        {
+            table.add(employee);
+        }
+        std::cout << result.records.size() << " employees loaded, " << result.errors.size() << " rejected in " << elapsed << " s" << std::endl;
+        std::cout << "Total net pay: " << formatCents(table.totalNetPayCents()) << std::endl;
+        for (const JobTotal& total : table.netPayByJob())
+        {
+            std::cout << "  " << total.job << " (" << total.employees << "): " << formatCents(total.netPayCents) << std::endl;
+        }
+        return result.errors.empty() ? 0 : 2;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 3 && std::strcmp(argv[1], "--bench-file") == 0)
+    {
+        EmployeeFile::benchmark(argv[2], std::stoull(argv[3]));
+        return 0;
+    }
+    if (argc > 2 && std::strcmp(argv[1], "--bench-index") == 0)
+    {
+        EmployeeIndex::benchmark(std::stoull(argv[2]));
+        return 0;
+    }
+    if (argc > 2 && std::strcmp(argv[1], "--load") == 0)
+    {
+        return EmployeeImport::load(argv[2], argc > 3 ? std::stoul(argv[3]) : 0);
+    }
+
     // Example of creating an employee
     Employee employee = {
         {"Mina", "Magdy", "Aziz"},                          // Name
@@ -71,5 +1241,61 @@ int main() {
     std::cout << "  Reductions: " << employee.salary.reductions << std::endl;
     std::cout << "  Taxes: " << employee.salary.taxes << std::endl;
 
+    // Payroll over a column store
+    EmployeeTable table;
+    table.add(employee);
+    table.add({ {"Sara", "Adel", "Hanna"}, {3, 2, 1995}, {"9", "Nasr City", "Cairo"},
+        {"0223456789", "01012345678", "sara@gmail.com"}, "Embedded Engineer", {42000.0, 3000.0, 0.0, 8000.0} });
+    table.add({ {"Omar", "Ali", "Hassan"}, {14, 11, 2000}, {"3", "Smouha", "Alexandria"},
+        {"0345678901", "01198765432", "omar@gmail.com"}, "Software Engineer", {38000.0, 1500.0, 500.0, 7000.0} });
+
+    std::cout << std::endl << "Total net pay: " << formatCents(table.totalNetPayCents()) << std::endl;
+    for (const JobTotal& total : table.netPayByJob())
+    {
+        std::cout << "  " << total.job << " (" << total.employees << "): " << formatCents(total.netPayCents) << std::endl;
+    }
+
+    // Round trip through the mappable record file, in a temporary file
+    std::string recordPath = (std::filesystem::temp_directory_path() / "employeesXXXXXX").string();
+    int recordFd = mkstemp(recordPath.data());
+    if (recordFd >= 0)
+    {
+        close(recordFd);
+        {
+            EmployeeFile::Writer writer(recordPath);
+            for (size_t i = 0; i < table.size(); i++)
+            {
+                writer.add(table.get(i));
+            }
+            writer.close();
+        }
+        {
+            EmployeeFile::Reader reader(recordPath.c_str());
+            for (size_t i = 0; i < reader.size(); i++)
+            {
+                std::cout << "  " << reader[i].firstName() << " " << reader[i].lastName() << " <" << reader[i].emailAddress()
+                    << ">: " << formatCents(reader[i].netPayCents()) << std::endl;
+            }
+        }
+        std::remove(recordPath.c_str());
+    }
+
+    // Indexed lookups
+    EmployeeIndex::Directory directory;
+    for (size_t i = 0; i < table.size(); i++)
+    {
+        directory.insert(table.get(i));
+    }
+    for (EmployeeIndex::RowId row : directory.query().emailIs("sara@gmail.com").run())
+    {
+        std::cout << std::endl << "sara@gmail.com: " << directory[row].name.firstName << " " << directory[row].name.lastName << std::endl;
+    }
+    std::cout << "Born 1995-2000 with basic >= 40000:";
+    for (EmployeeIndex::RowId row : directory.query().bornBetween({ 1, 1, 1995 }, { 31, 12, 2000 }).basicBetween(40000.0, 1e12).run())
+    {
+        std::cout << " " << directory[row].name.firstName;
+    }
+    std::cout << std::endl;
+
     return 0;
 }
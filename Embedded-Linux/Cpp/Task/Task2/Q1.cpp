@@ -1,5 +1,8 @@
 #include <iostream>
 #include <string>
+#include <vector>
+#include <cstring>
+#include "../RecordLoader.h"
 
 class Car
 {
@@ -40,7 +43,39 @@ public:
 	}
 };
 
-int main() {
+/* Loads cars from a CSV file (company,model,year header) or JSON Lines file */
+int loadCars(const char* path, unsigned threads)
+{
+	static const std::vector<RecordLoader::Field<Car>> fields = {
+		{ "company", [](Car& car, std::string_view v) { car.set_Company(std::string(v)); return true; } },
+		{ "model", [](Car& car, std::string_view v) { car.set_Model(std::string(v)); return true; } },
+		{ "year", [](Car& car, std::string_view v) { int year; if (!RecordLoader::ParseInt(v, year)) return false; car.set_Year(year); return true; } },
+	};
+
+	RecordLoader::Result<Car> result = RecordLoader::Load(path, fields, threads, Car("", "", 0));
+	if (!result.opened)
+	{
+		std::cout << "Error opening file!" << std::endl;
+		return 1;
+	}
+	for (const RecordLoader::LoadError& error : result.errors)
+	{
+		std::cerr << path << ":" << error.line << ": " << error.message << std::endl;
+	}
+	for (const Car& car : result.records)
+	{
+		std::cout << car.get_Company() << " " << car.get_Model() << " (" << car.get_Year() << ")" << std::endl;
+	}
+	std::cout << result.records.size() << " cars loaded, " << result.errors.size() << " rejected" << std::endl;
+	return result.errors.empty() ? 0 : 2;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 2 && std::strcmp(argv[1], "--load") == 0)
+	{
+		return loadCars(argv[2], argc > 3 ? std::stoul(argv[3]) : 0);
+	}
+
 	/* Create a Car object intialize with parameterize constructor */
 	Car myCar("Toyota", "Corolla", 2020);
 
@@ -1,6 +1,19 @@
 #include <iostream>
 #include <string>
-
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <charconv>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 class Calculator
 {
@@ -11,7 +24,7 @@ class Calculator
 		return n1 - n2;
 	}
 	double Multiplication(double n1, double n2){
-		return n1 - n2;
+		return n1 * n2;
 	}
 	double Division(double n1, double n2){
 		if (n2 == 0) {
@@ -31,47 +44,659 @@ class Calculator
 		return std::sqrt(a);
 	}
 public:
-	void Calculate(double n1, double n2, char Op)
+	/* Returns the result (0 on error) */
+	double Evaluate(double n1, double n2, char Op)
 	{
 		switch (Op)
 		{
 		case '+':
-			std::cout << "Result: " << Add(n1, n2) << std::endl;
-			break;
+			return Add(n1, n2);
 		case '-':
-			std::cout << "Result: " << Substruction(n1, n2) << std::endl;
-			break;
+			return Substruction(n1, n2);
 		case '*':
-			std::cout << "Result: " << Multiplication(n1, n2) << std::endl;
-			break;
+			return Multiplication(n1, n2);
 		case '/':
-			std::cout << "Result: " << Division(n1, n2) << std::endl;
-			break;
+			return Division(n1, n2);
 		case '^':
-			std::cout << "Result: " << power(n1, n2) << std::endl;
-			break;
+			return power(n1, n2);
 		default:
 			std::cerr << "Error: Invalid operator!" << std::endl;
-			break;
+			return 0;
 		}
 	}
 
-	void Calculate(double n1, char Op)
+	double Evaluate(double n1, char Op)
 	{
 		switch (Op)
 		{
 		case 's':
-			std::cout << "Result: " << square_root(n1) << std::endl;
-			break;
+			return square_root(n1);
 		default:
 			std::cerr << "Error: Invalid operator!" << std::endl;
-			break;
+			return 0;
 		}
 	}
+
+	void Calculate(double n1, double n2, char Op)
+	{
+		if (Op == '\0' || std::strchr("+-*/^", Op) == nullptr)
+		{
+			std::cerr << "Error: Invalid operator!" << std::endl;
+			return;
+		}
+		std::cout << "Result: " << Evaluate(n1, n2, Op) << std::endl;
+	}
+
+	void Calculate(double n1, char Op)
+	{
+		if (Op != 's')
+		{
+			std::cerr << "Error: Invalid operator!" << std::endl;
+			return;
+		}
+		std::cout << "Result: " << Evaluate(n1, Op) << std::endl;
+	}
 	
 };
 
-int main() {
+
+/*
+ * A formula such as "sqrt(a^2 + b^2) / 2" compiled once and evaluated over
+ * columns of doubles.
+ *
+ * Parsing builds a small tree in which constant subexpressions are folded
+ * (2 * 3 + a -> 6 + a), x * 1, x + 0, x - 0, x / 1 and x ^ 1 become x, and
+ * x ^ 2, x ^ 3 and x ^ 4 become multiplications. The tree is then flattened
+ * to register bytecode. Each register holds one batch of rows, and
+ * evaluation runs every instruction over a whole batch, so the dispatch cost
+ * is paid once per Batch rows instead of once per row.
+ *
+ * Semantics follow Calculator: x / 0 and sqrt(negative) give 0 (without the
+ * message), ^ is std::pow, and ^ binds tighter than unary minus (-2^2 = -4)
+ * and is right-associative.
+ */
+class Formula
+{
+public:
+	static constexpr size_t Batch = 512;
+
+private:
+	enum class Op : uint8_t { Add, Sub, Mul, Div, Pow, Sqrt, Neg };
+
+	struct Operand
+	{
+		enum Kind : uint8_t { Register, Column, Constant } kind;
+		uint32_t index;
+	};
+
+	struct Instruction
+	{
+		Op op;
+		uint32_t dst;
+		Operand a, b;
+	};
+
+	struct Node
+	{
+		enum Kind : uint8_t { Constant, Variable, Unary, Binary } kind;
+		Op op;
+		double value;
+		uint32_t variable;
+		int left, right;
+	};
+
+	std::vector<Instruction> code;
+	std::vector<double> constants;
+	Operand result = { Operand::Constant, 0 };
+	uint32_t registers = 0;
+	size_t columns = 0;
+	std::string message;
+
+	/* Parser state, only used while compiling */
+	std::string_view text;
+	size_t pos = 0;
+	const std::vector<std::string>* names = nullptr;
+	std::vector<Node> nodes;
+	std::vector<uint32_t> freeRegisters;
+
+	static double apply(Op op, double a, double b)
+	{
+		switch (op)
+		{
+		case Op::Add: return a + b;
+		case Op::Sub: return a - b;
+		case Op::Mul: return a * b;
+		case Op::Div: return b == 0 ? 0 : a / b;
+		case Op::Pow: return std::pow(a, b);
+		case Op::Sqrt: return a < 0 ? 0 : std::sqrt(a);
+		default: return -a;
+		}
+	}
+
+	bool fail(const std::string& what)
+	{
+		if (message.empty())
+		{
+			message = "Error: " + what + " at position " + std::to_string(pos);
+		}
+		return false;
+	}
+
+	void skipSpace()
+	{
+		while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) pos++;
+	}
+
+	bool isConstant(int node, double value) const
+	{
+		return nodes[node].kind == Node::Constant && nodes[node].value == value;
+	}
+
+	int constant(double value)
+	{
+		nodes.push_back({ Node::Constant, Op::Add, value, 0, -1, -1 });
+		return static_cast<int>(nodes.size() - 1);
+	}
+
+	int unary(Op op, int operand)
+	{
+		if (nodes[operand].kind == Node::Constant)
+		{
+			return constant(apply(op, nodes[operand].value, 0));
+		}
+		nodes.push_back({ Node::Unary, op, 0, 0, operand, -1 });
+		return static_cast<int>(nodes.size() - 1);
+	}
+
+	int binary(Op op, int left, int right)
+	{
+		if (nodes[left].kind == Node::Constant && nodes[right].kind == Node::Constant)
+		{
+			return constant(apply(op, nodes[left].value, nodes[right].value));
+		}
+		if ((op == Op::Mul && isConstant(left, 1)) || (op == Op::Add && isConstant(left, 0)))
+		{
+			return right;
+		}
+		if (((op == Op::Mul || op == Op::Div || op == Op::Pow) && isConstant(right, 1)) ||
+			((op == Op::Add || op == Op::Sub) && isConstant(right, 0)))
+		{
+			return left;
+		}
+		nodes.push_back({ Node::Binary, op, 0, 0, left, right });
+		return static_cast<int>(nodes.size() - 1);
+	}
+
+	/* expression := term (('+' | '-') term)* */
+	int parseExpression()
+	{
+		int left = parseTerm();
+		while (left >= 0)
+		{
+			skipSpace();
+			if (pos >= text.size() || (text[pos] != '+' && text[pos] != '-')) break;
+			Op op = text[pos++] == '+' ? Op::Add : Op::Sub;
+			int right = parseTerm();
+			if (right < 0) return -1;
+			left = binary(op, left, right);
+		}
+		return left;
+	}
+
+	/* term := unary (('*' | '/') unary)* */
+	int parseTerm()
+	{
+		int left = parseUnary();
+		while (left >= 0)
+		{
+			skipSpace();
+			if (pos >= text.size() || (text[pos] != '*' && text[pos] != '/')) break;
+			Op op = text[pos++] == '*' ? Op::Mul : Op::Div;
+			int right = parseUnary();
+			if (right < 0) return -1;
+			left = binary(op, left, right);
+		}
+		return left;
+	}
+
+	/* unary := ('-' | '+') unary | power */
+	int parseUnary()
+	{
+		skipSpace();
+		if (pos < text.size() && (text[pos] == '-' || text[pos] == '+'))
+		{
+			bool negate = text[pos++] == '-';
+			int operand = parseUnary();
+			if (operand < 0 || !negate) return operand;
+			return unary(Op::Neg, operand);
+		}
+		return parsePower();
+	}
+
+	/* power := primary ('^' unary)? */
+	int parsePower()
+	{
+		int base = parsePrimary();
+		if (base < 0) return -1;
+		skipSpace();
+		if (pos < text.size() && text[pos] == '^')
+		{
+			pos++;
+			int exponent = parseUnary();
+			if (exponent < 0) return -1;
+			return binary(Op::Pow, base, exponent);
+		}
+		return base;
+	}
+
+	/* primary := number | name | 'sqrt' '(' expression ')' | '(' expression ')' */
+	int parsePrimary()
+	{
+		skipSpace();
+		if (pos >= text.size()) return fail("unexpected end of formula"), -1;
+
+		char c = text[pos];
+		if (c == '(')
+		{
+			pos++;
+			int inner = parseExpression();
+			if (inner < 0) return -1;
+			skipSpace();
+			if (pos >= text.size() || text[pos] != ')') return fail("expected ')'"), -1;
+			pos++;
+			return inner;
+		}
+		if ((c >= '0' && c <= '9') || c == '.')
+		{
+			double value;
+			auto parsed = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+			if (parsed.ec != std::errc()) return fail("bad number"), -1;
+			pos = parsed.ptr - text.data();
+			return constant(value);
+		}
+		if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_')
+		{
+			size_t start = pos;
+			while (pos < text.size() && ((text[pos] >= 'a' && text[pos] <= 'z') || (text[pos] >= 'A' && text[pos] <= 'Z') ||
+				(text[pos] >= '0' && text[pos] <= '9') || text[pos] == '_'))
+			{
+				pos++;
+			}
+			std::string_view name = text.substr(start, pos - start);
+			for (size_t v = 0; v < names->size(); v++)
+			{
+				if (name == (*names)[v])
+				{
+					nodes.push_back({ Node::Variable, Op::Add, 0, static_cast<uint32_t>(v), -1, -1 });
+					return static_cast<int>(nodes.size() - 1);
+				}
+			}
+			if (name == "sqrt")
+			{
+				skipSpace();
+				if (pos >= text.size() || text[pos] != '(') return fail("expected '(' after sqrt"), -1;
+				int argument = parsePrimary();
+				if (argument < 0) return -1;
+				return unary(Op::Sqrt, argument);
+			}
+			pos = start;
+			return fail("unknown name '" + std::string(name) + "'"), -1;
+		}
+		return fail(std::string("unexpected '") + c + "'"), -1;
+	}
+
+	Operand allocate()
+	{
+		if (!freeRegisters.empty())
+		{
+			uint32_t index = freeRegisters.back();
+			freeRegisters.pop_back();
+			return { Operand::Register, index };
+		}
+		return { Operand::Register, registers++ };
+	}
+
+	void release(Operand operand)
+	{
+		if (operand.kind == Operand::Register) freeRegisters.push_back(operand.index);
+	}
+
+	Operand emit(Op op, Operand a, Operand b)
+	{
+		Operand dst = allocate();
+		code.push_back({ op, dst.index, a, b });
+		return dst;
+	}
+
+	/* Post-order walk; a register is freed after its last use so the result can reuse it */
+	Operand generate(int node)
+	{
+		const Node& n = nodes[node];
+		switch (n.kind)
+		{
+		case Node::Constant:
+			constants.push_back(n.value);
+			return { Operand::Constant, static_cast<uint32_t>(constants.size() - 1) };
+		case Node::Variable:
+			return { Operand::Column, n.variable };
+		case Node::Unary:
+		{
+			Operand a = generate(n.left);
+			release(a);
+			return emit(n.op, a, a);
+		}
+		default:
+			break;
+		}
+
+		if (n.op == Op::Pow && nodes[n.right].kind == Node::Constant)
+		{
+			double k = nodes[n.right].value;
+			if (k == 2 || k == 3 || k == 4)
+			{
+				Operand x = generate(n.left);
+				Operand square = emit(Op::Mul, x, x);
+				if (k == 2)
+				{
+					release(x);
+					return square;
+				}
+				release(square);
+				if (k == 4)
+				{
+					release(x);
+					return emit(Op::Mul, square, square);
+				}
+				release(x);
+				return emit(Op::Mul, square, x);
+			}
+		}
+
+		Operand a = generate(n.left);
+		Operand b = generate(n.right);
+		release(a);
+		release(b);
+		return emit(n.op, a, b);
+	}
+
+	/* dst[i] = a[i] op b[i] for i < count */
+	static void kernel(Op op, double* dst, const double* a, const double* b, size_t count)
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		const __m256d zero = _mm256_setzero_pd();
+		switch (op)
+		{
+		case Op::Add:
+			for (; i + 4 <= count; i += 4) _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			break;
+		case Op::Sub:
+			for (; i + 4 <= count; i += 4) _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			break;
+		case Op::Mul:
+			for (; i + 4 <= count; i += 4) _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+			break;
+		case Op::Div:
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d divisor = _mm256_loadu_pd(b + i);
+				__m256d quotient = _mm256_div_pd(_mm256_loadu_pd(a + i), divisor);
+				_mm256_storeu_pd(dst + i, _mm256_andnot_pd(_mm256_cmp_pd(divisor, zero, _CMP_EQ_OQ), quotient));
+			}
+			break;
+		case Op::Sqrt:
+			for (; i + 4 <= count; i += 4)
+			{
+				__m256d x = _mm256_loadu_pd(a + i);
+				_mm256_storeu_pd(dst + i, _mm256_andnot_pd(_mm256_cmp_pd(x, zero, _CMP_LT_OQ), _mm256_sqrt_pd(x)));
+			}
+			break;
+		case Op::Neg:
+			for (; i + 4 <= count; i += 4) _mm256_storeu_pd(dst + i, _mm256_sub_pd(zero, _mm256_loadu_pd(a + i)));
+			break;
+		default:
+			break;
+		}
+#elif defined(__SSE2__)
+		const __m128d zero = _mm_setzero_pd();
+		switch (op)
+		{
+		case Op::Add:
+			for (; i + 2 <= count; i += 2) _mm_storeu_pd(dst + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			break;
+		case Op::Sub:
+			for (; i + 2 <= count; i += 2) _mm_storeu_pd(dst + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			break;
+		case Op::Mul:
+			for (; i + 2 <= count; i += 2) _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+			break;
+		case Op::Div:
+			for (; i + 2 <= count; i += 2)
+			{
+				__m128d divisor = _mm_loadu_pd(b + i);
+				__m128d quotient = _mm_div_pd(_mm_loadu_pd(a + i), divisor);
+				_mm_storeu_pd(dst + i, _mm_andnot_pd(_mm_cmpeq_pd(divisor, zero), quotient));
+			}
+			break;
+		case Op::Sqrt:
+			for (; i + 2 <= count; i += 2)
+			{
+				__m128d x = _mm_loadu_pd(a + i);
+				_mm_storeu_pd(dst + i, _mm_andnot_pd(_mm_cmplt_pd(x, zero), _mm_sqrt_pd(x)));
+			}
+			break;
+		case Op::Neg:
+			for (; i + 2 <= count; i += 2) _mm_storeu_pd(dst + i, _mm_sub_pd(zero, _mm_loadu_pd(a + i)));
+			break;
+		default:
+			break;
+		}
+#endif
+		for (; i < count; i++)
+		{
+			dst[i] = apply(op, a[i], b[i]);
+		}
+	}
+
+	/* Rows [first, last) with per-thread registers */
+	void run(const double* const* data, size_t first, size_t last, double* out) const
+	{
+		std::vector<double> scratch((registers + constants.size()) * Batch);
+		double* regs = scratch.data();
+		double* consts = regs + registers * Batch;
+		for (size_t c = 0; c < constants.size(); c++)
+		{
+			std::fill(consts + c * Batch, consts + (c + 1) * Batch, constants[c]);
+		}
+
+		for (size_t row = first; row < last; row += Batch)
+		{
+			size_t count = std::min(Batch, last - row);
+			auto resolve = [&](Operand o) -> const double* {
+				switch (o.kind)
+				{
+				case Operand::Register: return regs + o.index * Batch;
+				case Operand::Column: return data[o.index] + row;
+				default: return consts + o.index * Batch;
+				}
+			};
+			for (size_t k = 0; k < code.size(); k++)
+			{
+				const Instruction& in = code[k];
+				bool final = k + 1 == code.size() && result.kind == Operand::Register;
+				double* dst = final ? out + row : regs + in.dst * Batch;
+				kernel(in.op, dst, resolve(in.a), resolve(in.b), count);
+			}
+			if (code.empty() || result.kind != Operand::Register)
+			{
+				const double* value = resolve(result);
+				std::copy(value, value + count, out + row);
+			}
+		}
+	}
+
+public:
+	/* Compiles text over the named variables; on failure error() says what and where */
+	bool compile(std::string_view formula, const std::vector<std::string>& variables)
+	{
+		*this = Formula();
+		text = formula;
+		names = &variables;
+		columns = variables.size();
+
+		int root = parseExpression();
+		skipSpace();
+		if (root >= 0 && pos < text.size())
+		{
+			root = -1;
+			fail(std::string("unexpected '") + text[pos] + "'");
+		}
+		if (root >= 0)
+		{
+			result = generate(root);
+		}
+		nodes.clear();
+		freeRegisters.clear();
+		names = nullptr;
+		text = std::string_view();
+		if (root < 0)
+		{
+			code.clear();
+			constants.assign(1, 0);
+			result = { Operand::Constant, 0 };
+			return false;
+		}
+		return true;
+	}
+
+	const std::string& error() const
+	{
+		return message;
+	}
+
+	/*
+	 * out[r] = formula(data[0][r], data[1][r], ...) for r < rows, where data
+	 * holds one column per variable. Rows are split between threads in whole
+	 * batches.
+	 */
+	void evaluate(const double* const* data, size_t rows, double* out, unsigned threads = 1) const
+	{
+		size_t batches = (rows + Batch - 1) / Batch;
+		threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, batches)));
+		std::vector<std::thread> workers;
+		for (unsigned t = 1; t < threads; t++)
+		{
+			workers.emplace_back([=] { run(data, batches * t / threads * Batch, std::min(rows, batches * (t + 1) / threads * Batch), out); });
+		}
+		run(data, 0, std::min(rows, batches / threads * Batch), out);
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	double evaluate(const std::vector<double>& values) const
+	{
+		std::vector<const double*> data;
+		for (const double& value : values) data.push_back(&value);
+		double out;
+		evaluate(data.data(), 1, &out);
+		return out;
+	}
+
+	/* One line per instruction, e.g. "r0 = a * a" */
+	std::string listing(const std::vector<std::string>& variables) const
+	{
+		auto name = [&](Operand o) {
+			if (o.kind == Operand::Register) return "r" + std::to_string(o.index);
+			if (o.kind == Operand::Column) return variables[o.index];
+			std::string number = std::to_string(constants[o.index]);
+			number.erase(number.find_last_not_of('0') + 1);
+			if (number.back() == '.') number.pop_back();
+			return number;
+		};
+		const char* symbols[] = { "+", "-", "*", "/", "^" };
+		std::string out;
+		for (const Instruction& in : code)
+		{
+			out += "r" + std::to_string(in.dst) + " = ";
+			if (in.op == Op::Sqrt) out += "sqrt(" + name(in.a) + ")";
+			else if (in.op == Op::Neg) out += "-" + name(in.a);
+			else out += name(in.a) + " " + symbols[static_cast<int>(in.op)] + " " + name(in.b);
+			out += "\n";
+		}
+		out += "result = " + name(result) + "\n";
+		return out;
+	}
+};
+
+/* Formula over rows x per-row Calculator calls and a hand-written loop */
+void benchmark(size_t rows, unsigned threads)
+{
+	std::vector<double> a(rows), b(rows), out(rows), expected(rows);
+	for (size_t i = 0; i < rows; i++)
+	{
+		a[i] = (i % 1000) * 0.5 - 100;
+		b[i] = (i % 777) * 0.25 + 1;
+	}
+	auto seconds = [](auto start) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	std::vector<std::string> names = { "a", "b" };
+	Formula formula;
+	formula.compile("sqrt(a^2 + b^2) * (2 + 3) / b - a", names);
+	const double* columns[] = { a.data(), b.data() };
+
+	/* Small inputs are repeated so every variant processes about 10M rows */
+	const size_t repeat = std::max<size_t>(1, 10000000 / std::max<size_t>(1, rows));
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < repeat; r++)
+	{
+		formula.evaluate(columns, rows, out.data(), threads);
+	}
+	double batched = seconds(start);
+
+	Calculator calc;
+	start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < repeat; r++)
+	{
+		for (size_t i = 0; i < rows; i++)
+		{
+			double sum = calc.Evaluate(calc.Evaluate(a[i], 2, '^'), calc.Evaluate(b[i], 2, '^'), '+');
+			expected[i] = calc.Evaluate(calc.Evaluate(calc.Evaluate(calc.Evaluate(sum, 's'), 5, '*'), b[i], '/'), a[i], '-');
+		}
+	}
+	double perRow = seconds(start);
+
+	start = std::chrono::steady_clock::now();
+	for (size_t r = 0; r < repeat; r++)
+	{
+		for (size_t i = 0; i < rows; i++)
+		{
+			expected[i] = std::sqrt(a[i] * a[i] + b[i] * b[i]) * 5 / b[i] - a[i];
+		}
+	}
+	double native = seconds(start);
+
+	double worst = 0;
+	for (size_t i = 0; i < rows; i++)
+	{
+		worst = std::max(worst, std::fabs(out[i] - expected[i]));
+	}
+	std::cout << formula.listing(names);
+	std::cout << rows << " rows x " << repeat << ": formula " << batched * 1e3 << " ms, Calculator per row " << perRow * 1e3
+		<< " ms, native loop " << native * 1e3 << " ms (max difference " << worst << ")" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 2 && std::strcmp(argv[1], "--bench") == 0)
+	{
+		benchmark(std::strtoull(argv[2], nullptr, 10), argc > 3 ? std::atoi(argv[3]) : std::thread::hardware_concurrency());
+		return 0;
+	}
+
 	Calculator calc;
 
 	calc.Calculate(5, 3, '+');
@@ -82,5 +707,30 @@ int main() {
 
 	calc.Calculate(9, 's');
 
+	/* Compile a formula once and evaluate it over columns */
+	std::vector<std::string> names = { "x", "y" };
+	Formula formula;
+	if (!formula.compile("sqrt(x^2 + y^2) * (1 + 1) - 10 / 2", names))
+	{
+		std::cerr << formula.error() << std::endl;
+		return 1;
+	}
+	std::cout << formula.listing(names);
+
+	std::vector<double> x = { 3, 5, 8, 7, 20 };
+	std::vector<double> y = { 4, 12, 15, 24, 21 };
+	std::vector<double> results(x.size());
+	const double* columns[] = { x.data(), y.data() };
+	formula.evaluate(columns, x.size(), results.data());
+	for (size_t i = 0; i < results.size(); i++)
+	{
+		std::cout << "Result: " << results[i] << std::endl;
+	}
+
+	if (!formula.compile("2 * (x + ", names))
+	{
+		std::cerr << formula.error() << std::endl;
+	}
+
 	return 0;
 }
\ No newline at end of file
@@ -1,6 +1,10 @@
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <chrono>
+#include <vector>
+#include "VertexGenerator.h"
 
 // Define the Vertex structure
 struct Vertex {
@@ -8,14 +12,82 @@ struct Vertex {
     int y;
 };
 
-int main() {
-    std::srand(std::time(0));
+// Coordinates are in [-100, 100]
+const int32_t Low = -100;
+const int32_t High = 100;
+
+// Chi-square statistic of the x values against a uniform distribution
+static double chiSquare(const std::vector<int32_t>& values) {
+    std::vector<size_t> counts(High - Low + 1, 0);
+    for (int32_t v : values) {
+        counts[v - Low]++;
+    }
+    double expected = double(values.size()) / counts.size();
+    double sum = 0;
+    for (size_t c : counts) {
+        sum += (c - expected) * (c - expected) / expected;
+    }
+    return sum;
+}
+
+// Generates count points with the bulk generator and with std::rand()
+static void benchmark(size_t count, unsigned threads, uint64_t seed) {
+    using Clock = std::chrono::steady_clock;
+    if (count == 0) {
+        std::cout << "Nothing to generate!\n";
+        return;
+    }
+
+    // Arrays are allocated and touched first so only generation is timed
+    VertexGenerator::Points points = VertexGenerator::generate(count, Low, High, seed + 1, threads);
+    auto start = Clock::now();
+    VertexGenerator::generate(points.x.data(), points.y.data(), count, Low, High, seed, threads);
+    double bulk = std::chrono::duration<double>(Clock::now() - start).count();
+
+    VertexGenerator::Points single = VertexGenerator::generate(count, Low, High, seed, 1);
+    bool same = points.x == single.x && points.y == single.y;
+
+    // Both coordinates per point, as the original generator drew them
+    std::vector<int32_t> legacyX(count), legacyY(count);
+    std::srand(seed);
+    start = Clock::now();
+    for (size_t i = 0; i < count; ++i) {
+        legacyX[i] = std::rand() % 201 - 100;
+        legacyY[i] = std::rand() % 201 - 100;
+    }
+    double legacyTime = std::chrono::duration<double>(Clock::now() - start).count();
+
+    // 200 degrees of freedom: about 200 +- 20 for a uniform source
+    std::cout << count << " points, seed " << seed << "\n";
+    std::cout << "  xoshiro256++ / Lemire (" << (threads ? threads : std::thread::hardware_concurrency()) << " threads): "
+              << bulk * 1e3 << " ms, " << bulk * 1e9 / count << " ns/point, chi-square " << chiSquare(points.x) << "\n";
+    std::cout << "  same points on 1 thread: " << (same ? "yes" : "NO") << "\n";
+    std::cout << "  std::rand() % 201: " << legacyTime * 1e3 << " ms, " << legacyTime * 1e9 / count << " ns/point, chi-square "
+              << chiSquare(legacyX) << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t seed = std::time(0);
+
+    // Usage: ./Q1 [--seed S] [--bench N [threads]]
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            size_t count = std::strtoull(argv[i + 1], nullptr, 10);
+            unsigned threads = i + 2 < argc ? std::atoi(argv[i + 2]) : 0;
+            benchmark(count, threads, seed);
+            return 0;
+        }
+    }
 
     // Generate 5 random vertices
+    int32_t x[5], y[5];
+    VertexGenerator::generate(x, y, 5, Low, High, seed);
     Vertex vertices[5];
     for (int i = 0; i < 5; ++i) {
-        vertices[i].x = std::rand() % 201 - 100; 
-        vertices[i].y = std::rand() % 201 - 100; 
+        vertices[i].x = x[i];
+        vertices[i].y = y[i];
     }
 
     // Output the vertices to the terminal
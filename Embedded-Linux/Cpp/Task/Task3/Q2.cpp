@@ -1,58 +1,169 @@
 #include <iostream>
 #include <cstdlib>
 #include <ctime>
+#include <cstring>
+#include <cstdint>
 #include <string>
+#include <vector>
+#include <chrono>
+#include "Vertex.h"
+#include "VertexIndex.h"
+#include "VertexGeometry.h"
 
-class Vertex
+namespace VertexIndex
 {
-    int x;
-    int y;
-public:
-    /* Default constructor */
-	Vertex():x(0), y(0){}
-
-    /* Member function to set(x, y) with random numbers */
-    void setRandomValues()
+    /*
+     * Builds both indexes over count random vertices, runs batches of queries
+     * on each and checks a sample of the answers against a linear scan.
+     */
+    void benchmark(size_t count, unsigned threads, uint64_t seed)
     {
-        x = std::rand() % 201 - 100;
-        y = std::rand() % 201 - 100;
-    }
+        using Clock = std::chrono::steady_clock;
+        auto seconds = [](Clock::time_point since) { return std::chrono::duration<double>(Clock::now() - since).count(); };
+        if (count == 0) {
+            std::cout << "Nothing to index!\n";
+            return;
+        }
 
-    // Getter for x
-    int getX() const {
-        return x;
-    }
+        std::vector<Vertex> vertices = randomVertices(count, seed, threads);
+        const size_t queries = 100000, ranges = 2000;
+        VertexGenerator::Points q = VertexGenerator::generate(queries, -110, 110, seed + 1, threads);
+        std::vector<Box> boxes(ranges);
+        for (size_t i = 0; i < ranges; i++) boxes[i] = Box{ q.x[i], q.y[i], q.x[i] + 4, q.y[i] + 4 };
+
+        // Reference answers for the first few queries
+        const size_t checked = 20;
+        std::vector<uint64_t> nearestDistance(checked, UINT64_MAX);
+        std::vector<size_t> inRadius(checked, 0), inBox(checked, 0);
+        auto start = Clock::now();
+        for (size_t i = 0; i < count; i++) {
+            const int32_t x = vertices[i].getX(), y = vertices[i].getY();
+            for (size_t k = 0; k < checked; k++) {
+                nearestDistance[k] = std::min(nearestDistance[k], distance2(q.x[k], q.y[k], x, y));
+                inRadius[k] += distance2(q.x[k], q.y[k], x, y) <= 9;
+                inBox[k] += x >= boxes[k].minX && x <= boxes[k].maxX && y >= boxes[k].minY && y <= boxes[k].maxY;
+            }
+        }
+        const double scan = seconds(start) / (3 * checked);
+
+        std::cout << count << " vertices, " << queries << " nearest / " << ranges << " radius 3 / " << ranges << " 5x5 box queries\n";
+        std::cout << "  linear scan: " << scan * 1e3 << " ms/query\n";
 
-    // Getter for y
-    int getY() const {
-        return y;
+        auto run = [&](const char* name, auto& index) {
+            auto begin = Clock::now();
+            index.build(vertices, threads);
+            const double build = seconds(begin);
+
+            begin = Clock::now();
+            std::vector<uint32_t> nearest = nearestBatch(index, q.x.data(), q.y.data(), queries, threads);
+            const double nearestTime = seconds(begin);
+            begin = Clock::now();
+            Matches radius = radiusBatch(index, q.x.data(), q.y.data(), ranges, 3, threads);
+            const double radiusTime = seconds(begin);
+            begin = Clock::now();
+            Matches box = boxBatch(index, boxes, threads);
+            const double boxTime = seconds(begin);
+
+            bool correct = true;
+            for (size_t k = 0; k < checked; k++) {
+                const Vertex& v = vertices[nearest[k]];
+                correct = correct && distance2(q.x[k], q.y[k], v.getX(), v.getY()) == nearestDistance[k];
+                correct = correct && radius.offsets[k + 1] - radius.offsets[k] == inRadius[k];
+                correct = correct && box.offsets[k + 1] - box.offsets[k] == inBox[k];
+            }
+            std::cout << "  " << name << ": build " << build * 1e3 << " ms, nearest " << nearestTime * 1e9 / queries
+                      << " ns/query, radius " << radiusTime * 1e6 / ranges << " us/query (" << radius.ids.size()
+                      << " matches), box " << boxTime * 1e6 / ranges << " us/query (" << box.ids.size()
+                      << " matches), " << (correct ? "matches linear scan" : "WRONG") << "\n";
+        };
+        Grid grid;
+        run("grid", grid);
+        KdTree tree;
+        run("k-d tree", tree);
     }
+}
 
-    /* Convert c and y into output string */
-    std::string toString()
+namespace VertexGeometry
+{
+    /* Times the kernels on count random vertices in [-range, range], 1 <= range <= MaxCoordinate */
+    void benchmark(size_t count, int32_t range, unsigned threads, uint64_t seed)
     {
-        return "Vertex(" + std::to_string(x) + "," + std::to_string(y) + ")";
-    }
+        using Clock = std::chrono::steady_clock;
+        auto seconds = [](Clock::time_point since) { return std::chrono::duration<double>(Clock::now() - since).count(); };
+        if (range < 1 || range > VertexIndex::MaxCoordinate) {
+            std::cout << "Range must be between 1 and " << VertexIndex::MaxCoordinate << "!\n";
+            return;
+        }
+        if (count == 0) {
+            std::cout << "Nothing to measure!\n";
+            return;
+        }
 
-	~Vertex()
-	{
-	}
+        std::vector<Vertex> vertices(count);
+        {
+            VertexGenerator::Points points = VertexGenerator::generate(count, -range, range, seed, threads);
+            for (size_t i = 0; i < count; ++i) {
+                vertices[i].setValues(points.x[i], points.y[i]);
+            }
+        }
+        std::cout << count << " vertices in [-" << range << ", " << range << "]\n";
 
-private:
+        auto start = Clock::now();
+        Summary s = summarize(vertices, threads);
+        double reduceTime = seconds(start);
+        std::cout << "  box [" << s.box.minX << ", " << s.box.maxX << "] x [" << s.box.minY << ", " << s.box.maxY
+                  << "], centroid (" << double(s.sumX) / count << ", " << double(s.sumY) / count << "): "
+                  << reduceTime * 1e3 << " ms\n";
 
-};
+        start = Clock::now();
+        std::vector<Vertex> hull = convexHull(vertices, threads);
+        double hullTime = seconds(start);
+        std::cout << "  convex hull, " << hull.size() << " corners: " << hullTime * 1e3 << " ms\n";
 
+        // The plain monotone chain sorts everything, so it is only run on smaller sets
+        if (count <= 20000000) {
+            start = Clock::now();
+            std::vector<Vertex> all = vertices;
+            std::vector<Vertex> reference = monotoneChain(all);
+            double chainTime = seconds(start);
+            bool same = reference.size() == hull.size();
+            for (size_t i = 0; same && i < hull.size(); i++) {
+                same = reference[i].getX() == hull[i].getX() && reference[i].getY() == hull[i].getY();
+            }
+            std::cout << "  monotone chain on every vertex: " << chainTime * 1e3 << " ms, "
+                      << (same ? "same hull" : "DIFFERENT HULL") << "\n";
+        }
+    }
+}
 
-int main() {
 
-    std::srand(std::time(0));
 
-    // Generate 5 random vertices
-    Vertex vertices[5];
-    for (int i = 0; i < 5; ++i) {
-        vertices[i].setRandomValues();
+int main(int argc, char* argv[]) {
+
+    // Usage: ./Q2 [--seed S] [--bench-index N [threads]] [--bench-geometry N [range [threads]]]
+    uint64_t seed = std::time(0);
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--bench-index") == 0 && i + 1 < argc) {
+            unsigned threads = i + 2 < argc ? std::atoi(argv[i + 2]) : 0;
+            VertexIndex::benchmark(std::strtoull(argv[i + 1], nullptr, 10), threads, seed);
+            return 0;
+        } else if (std::strcmp(argv[i], "--bench-geometry") == 0 && i + 1 < argc) {
+            long long range = i + 2 < argc ? std::atoll(argv[i + 2]) : 100;
+            if (range < 1 || range > VertexIndex::MaxCoordinate) {
+                std::cout << "Range must be between 1 and " << VertexIndex::MaxCoordinate << "!\n";
+                return 1;
+            }
+            unsigned threads = i + 3 < argc ? std::atoi(argv[i + 3]) : 0;
+            VertexGeometry::benchmark(std::strtoull(argv[i + 1], nullptr, 10), int32_t(range), threads, seed);
+            return 0;
+        }
     }
 
+    // Generate 5 random vertices
+    std::vector<Vertex> vertices = randomVertices(5, seed);
+
     // Output 
     for (int i = 0; i < 5; ++i) {
         std::cout << vertices[i].toString() << std::endl;
@@ -0,0 +1,79 @@
+#ifndef VERTEX_H
+#define VERTEX_H
+
+/*
+ * The Vertex class from Q2, shared with the spatial indexes (VertexIndex.h)
+ * and geometry kernels (VertexGeometry.h).
+ */
+
+#include <string>
+#include <vector>
+#include <ctime>
+#include <thread>
+#include <functional>
+#include "VertexGenerator.h"
+
+class Vertex
+{
+    int x;
+    int y;
+public:
+    /* Default constructor */
+	Vertex():x(0), y(0){}
+
+    /* Member function to set(x, y) with random numbers */
+    void setRandomValues()
+    {
+        static thread_local VertexGenerator::Xoshiro256pp rng(std::time(0) ^ std::hash<std::thread::id>()(std::this_thread::get_id()));
+        setRandomValues(rng);
+    }
+
+    /* Same, drawing from the caller's generator (reproducible from its seed) */
+    void setRandomValues(VertexGenerator::Xoshiro256pp& rng)
+    {
+        x = VertexGenerator::uniform(rng, -100, 100);
+        y = VertexGenerator::uniform(rng, -100, 100);
+    }
+
+    void setValues(int newX, int newY)
+    {
+        x = newX;
+        y = newY;
+    }
+
+    // Getter for x
+    int getX() const {
+        return x;
+    }
+
+    // Getter for y
+    int getY() const {
+        return y;
+    }
+
+    /* Convert c and y into output string */
+    std::string toString()
+    {
+        return "Vertex(" + std::to_string(x) + "," + std::to_string(y) + ")";
+    }
+
+	~Vertex()
+	{
+	}
+
+private:
+
+};
+
+/* count vertices in [-100, 100], generated in parallel from seed */
+inline std::vector<Vertex> randomVertices(size_t count, uint64_t seed, unsigned threads = 0)
+{
+    VertexGenerator::Points points = VertexGenerator::generate(count, -100, 100, seed, threads);
+    std::vector<Vertex> vertices(count);
+    for (size_t i = 0; i < count; ++i) {
+        vertices[i].setValues(points.x[i], points.y[i]);
+    }
+    return vertices;
+}
+
+#endif // VERTEX_H
@@ -0,0 +1,214 @@
+#ifndef VERTEX_GENERATOR_H
+#define VERTEX_GENERATOR_H
+
+/*
+ * Bulk random coordinates for the Vertex tasks (Q1.cpp, Q2.cpp).
+ *
+ * std::rand() takes a global lock in glibc and "% 201" favours the low
+ * values, because 2^31 is not a multiple of 201. This uses xoshiro256++
+ * (one 64-bit draw per point, 32 bits per coordinate) with Lemire's
+ * multiply-shift range reduction, which is exactly uniform: the rare draws
+ * that would be biased are rejected and redrawn.
+ *
+ * generate() fills separate x[] and y[] arrays (structure of arrays). The
+ * points are cut into fixed blocks of BlockSize; block b uses the seed's
+ * stream advanced by b jumps of 2^128 draws. The output depends only on the
+ * seed, not on how many threads produced it.
+ */
+
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+namespace VertexGenerator
+{
+    class Xoshiro256pp
+    {
+    private:
+        uint64_t s[4];
+
+        static uint64_t rotl(uint64_t x, int k)
+        {
+            return (x << k) | (x >> (64 - k));
+        }
+
+    public:
+        /* The state is expanded from the seed with splitmix64, as the authors recommend */
+        explicit Xoshiro256pp(uint64_t seed)
+        {
+            for (uint64_t& word : s)
+            {
+                seed += 0x9e3779b97f4a7c15ULL;
+                uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        uint64_t next()
+        {
+            const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+
+        /* Same as 2^128 calls to next(): gives non-overlapping streams */
+        void jump()
+        {
+            static const uint64_t polynomial[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+            uint64_t t[4] = { 0, 0, 0, 0 };
+            for (uint64_t word : polynomial)
+            {
+                for (int bit = 0; bit < 64; bit++)
+                {
+                    if (word & (uint64_t(1) << bit))
+                    {
+                        for (int i = 0; i < 4; i++) t[i] ^= s[i];
+                    }
+                    next();
+                }
+            }
+            for (int i = 0; i < 4; i++) s[i] = t[i];
+        }
+    };
+
+    /*
+     * Uniform value in [0, range) from 32 random bits (Lemire, "Fast Random
+     * Integer Generation in an Interval"). redraw supplies fresh bits in the
+     * rare case (probability < range / 2^32) that the first ones are rejected.
+     */
+    template <typename Redraw>
+    inline uint32_t bounded(uint32_t bits, uint32_t range, Redraw redraw)
+    {
+        uint64_t m = uint64_t(bits) * range;
+        uint32_t low = static_cast<uint32_t>(m);
+        if (low < range)
+        {
+            const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+            while (low < threshold)
+            {
+                m = uint64_t(redraw()) * range;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+
+    /* [lo, hi] must be non-empty and not the whole int32_t range, whose size does not fit in 32 bits */
+    inline bool validRange(int32_t lo, int32_t hi)
+    {
+        return lo <= hi && !(lo == INT32_MIN && hi == INT32_MAX);
+    }
+
+    /* Number of values in [lo, hi], for a valid range */
+    inline uint32_t span(int32_t lo, int32_t hi)
+    {
+        return static_cast<uint32_t>(hi) - static_cast<uint32_t>(lo) + 1;
+    }
+
+    inline int32_t offset(int32_t lo, uint32_t value)
+    {
+        return static_cast<int32_t>(static_cast<uint32_t>(lo) + value);
+    }
+
+    /* Uniform integer in [lo, hi], which must be a valid range */
+    inline int32_t uniform(Xoshiro256pp& rng, int32_t lo, int32_t hi)
+    {
+        assert(validRange(lo, hi));
+        auto redraw = [&rng] { return static_cast<uint32_t>(rng.next() >> 32); };
+        return offset(lo, bounded(redraw(), span(lo, hi), redraw));
+    }
+
+    const size_t BlockSize = size_t(1) << 16;
+
+    /* Points [first, last) of block-aligned range, starting from that block's stream */
+    inline void generateBlocks(int32_t* x, int32_t* y, size_t first, size_t last, int32_t lo, int32_t hi, Xoshiro256pp stream)
+    {
+        const uint32_t range = span(lo, hi);
+        for (size_t block = first; block < last; block += BlockSize)
+        {
+            Xoshiro256pp rng = stream;
+            auto redraw = [&rng] { return static_cast<uint32_t>(rng.next() >> 32); };
+            const size_t end = std::min(last, block + BlockSize);
+            for (size_t i = block; i < end; i++)
+            {
+                uint64_t bits = rng.next();
+                x[i] = offset(lo, bounded(static_cast<uint32_t>(bits >> 32), range, redraw));
+                y[i] = offset(lo, bounded(static_cast<uint32_t>(bits), range, redraw));
+            }
+            stream.jump();
+        }
+    }
+
+    /*
+     * x[i], y[i] uniform in [lo, hi] for i < n, reproducible from seed.
+     * threads == 0 uses every hardware thread. Returns false, writing
+     * nothing, if [lo, hi] is not a valid range.
+     */
+    inline bool generate(int32_t* x, int32_t* y, size_t n, int32_t lo, int32_t hi, uint64_t seed, unsigned threads = 0)
+    {
+        if (!validRange(lo, hi)) return false;
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        const size_t blocks = (n + BlockSize - 1) / BlockSize;
+        threads = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, blocks)));
+
+        std::vector<std::thread> workers;
+        Xoshiro256pp stream(seed);
+        size_t done = 0;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            const size_t until = blocks * (t + 1) / threads;
+            const size_t first = done * BlockSize;
+            const size_t last = std::min(n, until * BlockSize);
+            if (t + 1 == threads)
+            {
+                generateBlocks(x, y, first, last, lo, hi, stream);
+            }
+            else
+            {
+                workers.emplace_back(generateBlocks, x, y, first, last, lo, hi, stream);
+            }
+            for (; done < until; done++) stream.jump();
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        return true;
+    }
+
+    /* Coordinates as two parallel arrays */
+    struct Points
+    {
+        std::vector<int32_t> x;
+        std::vector<int32_t> y;
+
+        size_t size() const
+        {
+            return x.size();
+        }
+    };
+
+    /* No points if [lo, hi] is not a valid range */
+    inline Points generate(size_t n, int32_t lo, int32_t hi, uint64_t seed, unsigned threads = 0)
+    {
+        Points points;
+        if (!validRange(lo, hi)) return points;
+        points.x.resize(n);
+        points.y.resize(n);
+        generate(points.x.data(), points.y.data(), n, lo, hi, seed, threads);
+        return points;
+    }
+}
+
+#endif // VERTEX_GENERATOR_H
@@ -0,0 +1,262 @@
+#ifndef VERTEX_GEOMETRY_H
+#define VERTEX_GEOMETRY_H
+
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#include "Vertex.h"
+#include "VertexIndex.h"
+
+/*
+ * Geometry over large vertex sets: exact orientation, bounding box and
+ * centroid, and the convex hull. Coordinates must be within +-2^30, as for
+ * VertexIndex: coordinate differences then fit in 32 bits and their products
+ * in int64_t.
+ */
+namespace VertexGeometry
+{
+    // The reductions read a vector<Vertex> as pairs of ints: x0 y0 x1 y1 ...
+    static_assert(sizeof(Vertex) == 2 * sizeof(int) && std::is_standard_layout<Vertex>::value, "Vertex must be two ints");
+
+    /*
+     * 1 if a, b, c turn counter-clockwise, -1 if clockwise, 0 if collinear.
+     * Each product is below 2^62 but their difference can reach 2^63, so it
+     * is taken in 128 bits.
+     */
+    inline int orientation(int64_t ax, int64_t ay, int64_t bx, int64_t by, int64_t cx, int64_t cy)
+    {
+        const __int128 turn = static_cast<__int128>((bx - ax) * (cy - ay)) - (by - ay) * (cx - ax);
+        return (turn > 0) - (turn < 0);
+    }
+
+    inline int orientation(const Vertex& a, const Vertex& b, const Vertex& c)
+    {
+        return orientation(a.getX(), a.getY(), b.getX(), b.getY(), c.getX(), c.getY());
+    }
+
+    struct Summary
+    {
+        VertexIndex::Box box{ INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN };
+        int64_t sumX = 0, sumY = 0;
+        size_t count = 0;
+    };
+
+    /* Bounding box and coordinate sums of count vertices */
+    inline Summary reduce(const Vertex* vertices, size_t count)
+    {
+        Summary s;
+        s.count = count;
+        const int32_t* xy = reinterpret_cast<const int32_t*>(vertices);
+        size_t i = 0;
+        int32_t low[8], high[8];
+        int64_t sums[4];
+#if defined(__AVX2__)
+        // Lanes alternate x and y; four vertices per step
+        __m256i lo = _mm256_set1_epi32(INT32_MAX), hi = _mm256_set1_epi32(INT32_MIN), sum = _mm256_setzero_si256();
+        for (; i + 4 <= count; i += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(xy + 2 * i));
+            lo = _mm256_min_epi32(lo, v);
+            hi = _mm256_max_epi32(hi, v);
+            sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+            sum = _mm256_add_epi64(sum, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(low), lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(high), hi);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(sums), sum);
+        const int lanes = 8;
+#elif defined(__SSE2__)
+        // SSE2 has no 32-bit min/max or sign extension: compare and select, and
+        // widen by interleaving with the sign
+        __m128i lo = _mm_set1_epi32(INT32_MAX), hi = _mm_set1_epi32(INT32_MIN), sum = _mm_setzero_si128();
+        for (; i + 2 <= count; i += 2) {
+            __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(xy + 2 * i));
+            __m128i less = _mm_cmplt_epi32(v, lo), greater = _mm_cmpgt_epi32(v, hi);
+            lo = _mm_or_si128(_mm_and_si128(less, v), _mm_andnot_si128(less, lo));
+            hi = _mm_or_si128(_mm_and_si128(greater, v), _mm_andnot_si128(greater, hi));
+            __m128i sign = _mm_srai_epi32(v, 31);
+            sum = _mm_add_epi64(sum, _mm_unpacklo_epi32(v, sign));
+            sum = _mm_add_epi64(sum, _mm_unpackhi_epi32(v, sign));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(low), lo);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(high), hi);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(sums), sum);
+        const int lanes = 4;
+#else
+        low[0] = low[1] = INT32_MAX;
+        high[0] = high[1] = INT32_MIN;
+        sums[0] = sums[1] = 0;
+        const int lanes = 2;
+#endif
+        for (int lane = 0; lane < lanes; lane += 2) {
+            s.box.minX = std::min(s.box.minX, low[lane]);
+            s.box.minY = std::min(s.box.minY, low[lane + 1]);
+            s.box.maxX = std::max(s.box.maxX, high[lane]);
+            s.box.maxY = std::max(s.box.maxY, high[lane + 1]);
+        }
+        for (int lane = 0; lane < lanes / 2; lane += 2) {
+            s.sumX += sums[lane];
+            s.sumY += sums[lane + 1];
+        }
+        for (; i < count; i++) {
+            const int32_t x = xy[2 * i], y = xy[2 * i + 1];
+            s.box.minX = std::min(s.box.minX, x);
+            s.box.minY = std::min(s.box.minY, y);
+            s.box.maxX = std::max(s.box.maxX, x);
+            s.box.maxY = std::max(s.box.maxY, y);
+            s.sumX += x;
+            s.sumY += y;
+        }
+        return s;
+    }
+
+    inline Summary summarize(const std::vector<Vertex>& vertices, unsigned threads = 0)
+    {
+        threads = VertexIndex::resolveThreads(threads, vertices.size());
+        std::vector<Summary> parts(threads);
+        VertexIndex::parallelFor(vertices.size(), threads, [&](unsigned t, size_t begin, size_t end) {
+            parts[t] = reduce(vertices.data() + begin, end - begin);
+        });
+        Summary all;
+        for (const Summary& part : parts) {
+            all.box.minX = std::min(all.box.minX, part.box.minX);
+            all.box.minY = std::min(all.box.minY, part.box.minY);
+            all.box.maxX = std::max(all.box.maxX, part.box.maxX);
+            all.box.maxY = std::max(all.box.maxY, part.box.maxY);
+            all.sumX += part.sumX;
+            all.sumY += part.sumY;
+            all.count += part.count;
+        }
+        return all;
+    }
+
+    /* Inclusive bounding box; minX > maxX when there are no vertices */
+    inline VertexIndex::Box boundingBox(const std::vector<Vertex>& vertices, unsigned threads = 0)
+    {
+        return summarize(vertices, threads).box;
+    }
+
+    /* Mean of the vertices, (0, 0) when there are none */
+    inline std::pair<double, double> centroid(const std::vector<Vertex>& vertices, unsigned threads = 0)
+    {
+        Summary s = summarize(vertices, threads);
+        if (s.count == 0) return { 0.0, 0.0 };
+        return { double(s.sumX) / s.count, double(s.sumY) / s.count };
+    }
+
+    inline bool lessXY(const Vertex& a, const Vertex& b)
+    {
+        return a.getX() < b.getX() || (a.getX() == b.getX() && a.getY() < b.getY());
+    }
+
+    /*
+     * Andrew's monotone chain on points (reordered in place): hull corners
+     * counter-clockwise from the lowest x (then lowest y), without collinear
+     * points. One or two distinct points come back as they are.
+     */
+    inline std::vector<Vertex> monotoneChain(std::vector<Vertex>& points)
+    {
+        std::sort(points.begin(), points.end(), lessXY);
+        points.erase(std::unique(points.begin(), points.end(), [](const Vertex& a, const Vertex& b) {
+            return a.getX() == b.getX() && a.getY() == b.getY();
+        }), points.end());
+        if (points.size() < 3) return points;
+
+        std::vector<Vertex> hull(2 * points.size());
+        size_t k = 0;
+        for (size_t i = 0; i < points.size(); i++) {
+            while (k >= 2 && orientation(hull[k - 2], hull[k - 1], points[i]) <= 0) k--;
+            hull[k++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = k + 1; i-- > 0;) {
+            while (k >= lower && orientation(hull[k - 2], hull[k - 1], points[i]) <= 0) k--;
+            hull[k++] = points[i];
+        }
+        hull.resize(k - 1);
+        return hull;
+    }
+
+    /*
+     * Convex hull, in the same form as monotoneChain().
+     *
+     * The extreme vertices of a sample in eight directions (x, y, x + y,
+     * x - y, both ways) form a polygon inside the hull, and nothing strictly
+     * inside it can be a corner (Akl-Toussaint). Each thread drops those
+     * vertices from its slice and runs the monotone chain on what is left;
+     * the hull of the slice hulls is the answer. For random points almost
+     * everything is dropped, so the sorts only see a small fraction.
+     */
+    inline std::vector<Vertex> convexHull(const std::vector<Vertex>& vertices, unsigned threads = 0)
+    {
+        const size_t n = vertices.size();
+        threads = VertexIndex::resolveThreads(threads, n);
+
+        // Extremes of a sample of the vertices, in directions counter-clockwise from
+        // straight down; any sample gives a polygon inside the hull
+        const size_t stride = std::max<size_t>(1, n / 65536);
+        size_t best[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+        int64_t value[8] = { INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN, INT64_MIN };
+        for (size_t i = 0; i < n; i += stride) {
+            const int64_t x = vertices[i].getX(), y = vertices[i].getY();
+            const int64_t v[8] = { -y, x - y, x, x + y, y, y - x, -x, -x - y };
+            for (int d = 0; d < 8; d++) {
+                if (v[d] > value[d]) {
+                    value[d] = v[d];
+                    best[d] = i;
+                }
+            }
+        }
+        std::vector<Vertex> polygon;
+        for (int d = 0; d < 8 && n > 0; d++) {
+            const Vertex& v = vertices[best[d]];
+            if (polygon.empty() || v.getX() != polygon.back().getX() || v.getY() != polygon.back().getY()) {
+                polygon.push_back(v);
+            }
+        }
+        while (polygon.size() > 1 && polygon.front().getX() == polygon.back().getX() && polygon.front().getY() == polygon.back().getY()) {
+            polygon.pop_back();
+        }
+
+        // Edge e keeps points p with ex*py - ey*px <= c, i.e. not strictly left of it.
+        // Short polygons repeat their edges to make eight; with fewer than three
+        // corners nothing is strictly inside and every vertex is kept
+        const bool filter = polygon.size() >= 3;
+        int64_t ex[8] = {}, ey[8] = {}, c[8] = {};
+        for (size_t e = 0; e < 8 && filter; e++) {
+            const Vertex& from = polygon[e % polygon.size()];
+            const Vertex& to = polygon[(e + 1) % polygon.size()];
+            ex[e] = int64_t(to.getX()) - from.getX();
+            ey[e] = int64_t(to.getY()) - from.getY();
+            c[e] = ex[e] * from.getY() - ey[e] * from.getX();
+        }
+
+        std::vector<std::vector<Vertex>> hulls(threads);
+        VertexIndex::parallelFor(n, threads, [&](unsigned t, size_t begin, size_t end) {
+            std::vector<Vertex> kept;
+            for (size_t i = begin; i < end; i++) {
+                const int64_t x = vertices[i].getX(), y = vertices[i].getY();
+                bool inside = filter;
+                for (int e = 0; e < 8; e++) {
+                    inside &= ex[e] * y - ey[e] * x > c[e];
+                }
+                if (!inside) kept.push_back(vertices[i]);
+            }
+            hulls[t] = monotoneChain(kept);
+        });
+
+        std::vector<Vertex> corners;
+        for (const std::vector<Vertex>& hull : hulls) {
+            corners.insert(corners.end(), hull.begin(), hull.end());
+        }
+        return monotoneChain(corners);
+    }
+}
+
+#endif // VERTEX_GEOMETRY_H
@@ -0,0 +1,455 @@
+#ifndef VERTEX_INDEX_H
+#define VERTEX_INDEX_H
+
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include "Vertex.h"
+
+/*
+ * Spatial indexes over a set of vertices, for nearest-neighbour, radius and
+ * box queries without scanning every pair. Results are positions in the
+ * vector the index was built from.
+ *
+ *   Grid    uniform grid stored as one array sorted by cell (counting sort),
+ *           for dense bounded domains such as [-100, 100]
+ *   KdTree  implicit k-d tree: the points are reordered so that every
+ *           subtree is a contiguous range with its splitting point in the
+ *           middle, no child pointers; works for any distribution
+ *
+ * Both build on several threads. The *Batch functions split a set of
+ * queries across threads. Coordinates, of vertices and queries, must be
+ * within +-2^30, so that squared distances (up to 2^63) fit in uint64_t.
+ */
+namespace VertexIndex
+{
+    const uint32_t NoVertex = UINT32_MAX;
+
+    /* Largest coordinate magnitude the indexes (and VertexGeometry) handle exactly */
+    const int32_t MaxCoordinate = 1 << 30;
+
+    /* Inclusive rectangle */
+    struct Box
+    {
+        int32_t minX, minY, maxX, maxY;
+    };
+
+    struct Point
+    {
+        int32_t x, y;
+        uint32_t id;
+    };
+
+    inline uint64_t distance2(int64_t x0, int64_t y0, int64_t x1, int64_t y1)
+    {
+        const uint64_t dx = static_cast<uint64_t>(x0 > x1 ? x0 - x1 : x1 - x0);
+        const uint64_t dy = static_cast<uint64_t>(y0 > y1 ? y0 - y1 : y1 - y0);
+        return dx * dx + dy * dy;
+    }
+
+    inline unsigned resolveThreads(unsigned threads, size_t count)
+    {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(threads, count / 4096)));
+    }
+
+    /* body(t, begin, end) on threads contiguous slices of [0, count) */
+    template <typename Body>
+    void parallelFor(size_t count, unsigned threads, Body body)
+    {
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threads; t++) {
+            workers.emplace_back(body, t, count * t / threads, count * (t + 1) / threads);
+        }
+        body(0, size_t(0), count / threads);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    class Grid
+    {
+        /* Per-thread bucket counts in build() are bounded by this, not by the cell count */
+        static const size_t MaxBuckets = 4096;
+
+        int32_t minX = 0, minY = 0;
+        int32_t cell = 1;
+        int32_t columns = 0, rows = 0;
+        std::vector<uint32_t> start;    // points of cell c are [start[c], start[c + 1])
+        std::vector<Point> points;      // sorted by cell, then by id
+
+        static int64_t floorDivide(int64_t a, int64_t b)
+        {
+            return a / b - (a % b != 0 && a < 0);
+        }
+
+        int32_t columnOf(int64_t x) const
+        {
+            return static_cast<int32_t>(std::min<int64_t>(columns - 1, std::max<int64_t>(0, (x - minX) / cell)));
+        }
+
+        int32_t rowOf(int64_t y) const
+        {
+            return static_cast<int32_t>(std::min<int64_t>(rows - 1, std::max<int64_t>(0, (y - minY) / cell)));
+        }
+
+        /* Calls visit(point) for every point in cells [c0, c1] x [r0, r1] */
+        template <typename Visit>
+        void scan(int32_t c0, int32_t r0, int32_t c1, int32_t r1, Visit visit) const
+        {
+            for (int32_t r = r0; r <= r1; r++) {
+                const uint32_t* row = &start[size_t(r) * columns];
+                for (uint32_t i = row[c0]; i < row[c1 + 1]; i++) {
+                    visit(points[i]);
+                }
+            }
+        }
+
+    public:
+        /* Cells are chosen to hold about two points each, and are at least 1 wide */
+        void build(const std::vector<Vertex>& vertices, unsigned threads = 0)
+        {
+            const size_t n = vertices.size();
+            points.assign(n, Point());
+            start.assign(1, 0);
+            columns = rows = 0;
+            if (n == 0) return;
+            threads = resolveThreads(threads, n);
+
+            std::vector<Box> bounds(threads, Box{ INT32_MAX, INT32_MAX, INT32_MIN, INT32_MIN });
+            parallelFor(n, threads, [&](unsigned t, size_t begin, size_t end) {
+                Box b = bounds[t];
+                for (size_t i = begin; i < end; i++) {
+                    b.minX = std::min(b.minX, vertices[i].getX());
+                    b.maxX = std::max(b.maxX, vertices[i].getX());
+                    b.minY = std::min(b.minY, vertices[i].getY());
+                    b.maxY = std::max(b.maxY, vertices[i].getY());
+                }
+                bounds[t] = b;
+            });
+            Box all = bounds[0];
+            for (const Box& b : bounds) {
+                all.minX = std::min(all.minX, b.minX);
+                all.minY = std::min(all.minY, b.minY);
+                all.maxX = std::max(all.maxX, b.maxX);
+                all.maxY = std::max(all.maxY, b.maxY);
+            }
+
+            const double width = double(all.maxX) - all.minX + 1, height = double(all.maxY) - all.minY + 1;
+            cell = static_cast<int32_t>(std::max(1.0, std::ceil(std::sqrt(width * height / (n / 2.0 + 1)))));
+            minX = all.minX;
+            minY = all.minY;
+            columns = static_cast<int32_t>((width + cell - 1) / cell);
+            rows = static_cast<int32_t>((height + cell - 1) / cell);
+            const size_t cells = size_t(columns) * rows;
+
+            // Counting sort in two passes, so that extra memory is O(n + cells)
+            // whatever the thread count. First each thread counts its slice into
+            // buckets of consecutive cells and spreads its points after those of
+            // the lower threads in every bucket; then each thread sorts a run of
+            // whole buckets by cell, with counts for only the cells it owns
+            std::vector<uint32_t> cellOf(n);
+            int shift = 0;
+            while (((cells - 1) >> shift) >= MaxBuckets) shift++;
+            const size_t buckets = ((cells - 1) >> shift) + 1;
+            std::vector<std::vector<uint32_t>> bucketNext(threads, std::vector<uint32_t>(buckets, 0));
+            parallelFor(n, threads, [&](unsigned t, size_t begin, size_t end) {
+                std::vector<uint32_t>& count = bucketNext[t];
+                for (size_t i = begin; i < end; i++) {
+                    uint32_t c = uint32_t(rowOf(vertices[i].getY())) * columns + columnOf(vertices[i].getX());
+                    cellOf[i] = c;
+                    count[c >> shift]++;
+                }
+            });
+            std::vector<uint32_t> bucketStart(buckets + 1);
+            uint32_t total = 0;
+            for (size_t b = 0; b < buckets; b++) {
+                bucketStart[b] = total;
+                for (unsigned t = 0; t < threads; t++) {
+                    uint32_t count = bucketNext[t][b];
+                    bucketNext[t][b] = total;
+                    total += count;
+                }
+            }
+            bucketStart[buckets] = total;
+            std::vector<uint32_t> order(n);
+            parallelFor(n, threads, [&](unsigned t, size_t begin, size_t end) {
+                std::vector<uint32_t>& next = bucketNext[t];
+                for (size_t i = begin; i < end; i++) {
+                    order[next[cellOf[i] >> shift]++] = uint32_t(i);
+                }
+            });
+
+            // Thread t takes the buckets from splitAt(t), about n / threads points each
+            auto splitAt = [&](unsigned t) {
+                if (t == threads) return buckets;
+                return size_t(std::lower_bound(bucketStart.begin(), bucketStart.begin() + buckets, uint32_t(n * t / threads)) - bucketStart.begin());
+            };
+            start.assign(cells + 1, 0);
+            parallelFor(threads, threads, [&](unsigned t, size_t, size_t) {
+                const size_t b0 = splitAt(t), b1 = splitAt(t + 1);
+                if (b0 == b1) return;
+                const size_t c0 = b0 << shift, c1 = std::min(cells, b1 << shift);
+                std::vector<uint32_t> next(c1 - c0, 0);
+                for (uint32_t k = bucketStart[b0]; k < bucketStart[b1]; k++) {
+                    next[cellOf[order[k]] - c0]++;
+                }
+                uint32_t first = bucketStart[b0];
+                for (size_t c = c0; c < c1; c++) {
+                    start[c] = first;
+                    uint32_t count = next[c - c0];
+                    next[c - c0] = first;
+                    first += count;
+                }
+                for (uint32_t k = bucketStart[b0]; k < bucketStart[b1]; k++) {
+                    const uint32_t i = order[k];
+                    points[next[cellOf[i] - c0]++] = Point{ vertices[i].getX(), vertices[i].getY(), i };
+                }
+            });
+            start[cells] = total;
+        }
+
+        size_t size() const
+        {
+            return points.size();
+        }
+
+        /*
+         * Closest vertex to (x, y), lowest position on ties; NoVertex if empty.
+         * Searches rings of cells outwards until no unvisited cell can be closer.
+         */
+        uint32_t nearest(int32_t x, int32_t y) const
+        {
+            if (points.empty()) return NoVertex;
+            // Cell of the query, which may lie outside the grid
+            const int64_t cx = floorDivide(int64_t(x) - minX, cell), cy = floorDivide(int64_t(y) - minY, cell);
+            const int64_t first = std::max({ int64_t(0), -cx, cx - (columns - 1), -cy, cy - (rows - 1) });
+            const int64_t last = std::max({ cx, columns - 1 - cx, cy, rows - 1 - cy });
+            uint32_t best = NoVertex;
+            uint64_t bestDistance = UINT64_MAX;
+            auto visit = [&](const Point& p) {
+                uint64_t d = distance2(x, y, p.x, p.y);
+                if (d < bestDistance || (d == bestDistance && p.id < best)) {
+                    bestDistance = d;
+                    best = p.id;
+                }
+            };
+
+            for (int64_t r = first; r <= last; r++) {
+                const int32_t c0 = int32_t(std::max<int64_t>(0, cx - r)), c1 = int32_t(std::min<int64_t>(columns - 1, cx + r));
+                const int32_t r0 = int32_t(std::max<int64_t>(0, cy - r + 1)), r1 = int32_t(std::min<int64_t>(rows - 1, cy + r - 1));
+                if (cy - r >= 0 && cy - r < rows) scan(c0, int32_t(cy - r), c1, int32_t(cy - r), visit);
+                if (r > 0 && cy + r >= 0 && cy + r < rows) scan(c0, int32_t(cy + r), c1, int32_t(cy + r), visit);
+                if (r0 <= r1 && cx - r >= 0 && cx - r < columns) scan(int32_t(cx - r), r0, int32_t(cx - r), r1, visit);
+                if (r0 <= r1 && r > 0 && cx + r >= 0 && cx + r < columns) scan(int32_t(cx + r), r0, int32_t(cx + r), r1, visit);
+
+                // Anything outside the rings so far is at least this far away
+                const int64_t left = x - (minX + (cx - r) * cell) + 1;
+                const int64_t right = minX + (cx + r + 1) * cell - x;
+                const int64_t bottom = y - (minY + (cy - r) * cell) + 1;
+                const int64_t top = minY + (cy + r + 1) * cell - y;
+                const int64_t reach = std::min({ left, right, bottom, top });
+                if (best != NoVertex && ((reach >> 32) || uint64_t(reach * reach) > bestDistance)) break;
+            }
+            return best;
+        }
+
+        /* Appends every vertex inside the box to out */
+        void box(const Box& b, std::vector<uint32_t>& out) const
+        {
+            if (points.empty() || b.minX > b.maxX || b.minY > b.maxY) return;
+            scan(columnOf(b.minX), rowOf(b.minY), columnOf(b.maxX), rowOf(b.maxY), [&](const Point& p) {
+                if (p.x >= b.minX && p.x <= b.maxX && p.y >= b.minY && p.y <= b.maxY) out.push_back(p.id);
+            });
+        }
+
+        /* Appends every vertex within distance r of (x, y) to out */
+        void radius(int32_t x, int32_t y, int32_t r, std::vector<uint32_t>& out) const
+        {
+            if (points.empty() || r < 0) return;
+            const uint64_t r2 = uint64_t(r) * uint64_t(r);
+            scan(columnOf(int64_t(x) - r), rowOf(int64_t(y) - r), columnOf(int64_t(x) + r), rowOf(int64_t(y) + r), [&](const Point& p) {
+                if (distance2(x, y, p.x, p.y) <= r2) out.push_back(p.id);
+            });
+        }
+    };
+
+    class KdTree
+    {
+        static const size_t Leaf = 16;     // ranges this small are scanned, not split
+        std::vector<Point> points;
+
+        static int32_t key(const Point& p, int axis)
+        {
+            return axis ? p.y : p.x;
+        }
+
+        /* Median of [lo, hi) on axis goes to the middle; left of it <= median <= right of it */
+        void split(size_t lo, size_t hi, int axis, unsigned threads)
+        {
+            if (hi - lo <= Leaf) return;
+            const size_t mid = lo + (hi - lo) / 2;
+            std::nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi, [axis](const Point& a, const Point& b) {
+                return key(a, axis) < key(b, axis);
+            });
+            if (threads > 1) {
+                std::thread left(&KdTree::split, this, lo, mid, axis ^ 1, threads / 2);
+                split(mid + 1, hi, axis ^ 1, threads - threads / 2);
+                left.join();
+            } else {
+                split(lo, mid, axis ^ 1, 1);
+                split(mid + 1, hi, axis ^ 1, 1);
+            }
+        }
+
+        void nearest(size_t lo, size_t hi, int axis, int32_t x, int32_t y, uint32_t& best, uint64_t& bestDistance) const
+        {
+            auto visit = [&](const Point& p) {
+                uint64_t d = distance2(x, y, p.x, p.y);
+                if (d < bestDistance || (d == bestDistance && p.id < best)) {
+                    bestDistance = d;
+                    best = p.id;
+                }
+            };
+            if (hi - lo <= Leaf) {
+                for (size_t i = lo; i < hi; i++) visit(points[i]);
+                return;
+            }
+            const size_t mid = lo + (hi - lo) / 2;
+            const Point& split = points[mid];
+            visit(split);
+            const int64_t gap = int64_t(axis ? y : x) - key(split, axis);
+            if (gap <= 0) {
+                nearest(lo, mid, axis ^ 1, x, y, best, bestDistance);
+                if (uint64_t(gap * gap) <= bestDistance) nearest(mid + 1, hi, axis ^ 1, x, y, best, bestDistance);
+            } else {
+                nearest(mid + 1, hi, axis ^ 1, x, y, best, bestDistance);
+                if (uint64_t(gap * gap) <= bestDistance) nearest(lo, mid, axis ^ 1, x, y, best, bestDistance);
+            }
+        }
+
+        /* Calls visit(point) for the points whose subtree may reach the box */
+        template <typename Visit>
+        void box(size_t lo, size_t hi, int axis, const Box& b, Visit& visit) const
+        {
+            if (hi - lo <= Leaf) {
+                for (size_t i = lo; i < hi; i++) visit(points[i]);
+                return;
+            }
+            const size_t mid = lo + (hi - lo) / 2;
+            const int32_t split = key(points[mid], axis);
+            visit(points[mid]);
+            if ((axis ? b.minY : b.minX) <= split) box(lo, mid, axis ^ 1, b, visit);
+            if ((axis ? b.maxY : b.maxX) >= split) box(mid + 1, hi, axis ^ 1, b, visit);
+        }
+
+    public:
+        void build(const std::vector<Vertex>& vertices, unsigned threads = 0)
+        {
+            const size_t n = vertices.size();
+            points.resize(n);
+            threads = resolveThreads(threads, n);
+            parallelFor(n, threads, [&](unsigned, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    points[i] = Point{ vertices[i].getX(), vertices[i].getY(), uint32_t(i) };
+                }
+            });
+            split(0, n, 0, threads);
+        }
+
+        size_t size() const
+        {
+            return points.size();
+        }
+
+        /* Closest vertex to (x, y), lowest position on ties; NoVertex if empty */
+        uint32_t nearest(int32_t x, int32_t y) const
+        {
+            uint32_t best = NoVertex;
+            uint64_t bestDistance = UINT64_MAX;
+            nearest(0, points.size(), 0, x, y, best, bestDistance);
+            return best;
+        }
+
+        /* Appends every vertex inside the box to out */
+        void box(const Box& b, std::vector<uint32_t>& out) const
+        {
+            auto visit = [&](const Point& p) {
+                if (p.x >= b.minX && p.x <= b.maxX && p.y >= b.minY && p.y <= b.maxY) out.push_back(p.id);
+            };
+            box(0, points.size(), 0, b, visit);
+        }
+
+        /* Appends every vertex within distance r of (x, y) to out */
+        void radius(int32_t x, int32_t y, int32_t r, std::vector<uint32_t>& out) const
+        {
+            if (r < 0) return;
+            const uint64_t r2 = uint64_t(r) * uint64_t(r);
+            const Box b{ int32_t(std::max<int64_t>(INT32_MIN, int64_t(x) - r)), int32_t(std::max<int64_t>(INT32_MIN, int64_t(y) - r)),
+                         int32_t(std::min<int64_t>(INT32_MAX, int64_t(x) + r)), int32_t(std::min<int64_t>(INT32_MAX, int64_t(y) + r)) };
+            auto visit = [&](const Point& p) {
+                if (distance2(x, y, p.x, p.y) <= r2) out.push_back(p.id);
+            };
+            box(0, points.size(), 0, b, visit);
+        }
+    };
+
+    /* Answers to a batch of range queries: query q matched ids[offsets[q]] .. ids[offsets[q + 1] - 1] */
+    struct Matches
+    {
+        std::vector<size_t> offsets;
+        std::vector<uint32_t> ids;
+    };
+
+    /* query(q, out) appends the matches of query q; the batch is split across threads */
+    template <typename Query>
+    Matches collect(size_t count, unsigned threads, Query query)
+    {
+        threads = count ? std::max(1u, std::min<unsigned>(threads ? threads : std::thread::hardware_concurrency(), unsigned(count))) : 1;
+        std::vector<Matches> parts(threads);
+        parallelFor(count, threads, [&](unsigned t, size_t begin, size_t end) {
+            Matches& part = parts[t];
+            for (size_t q = begin; q < end; q++) {
+                part.offsets.push_back(part.ids.size());
+                query(q, part.ids);
+            }
+        });
+
+        Matches all;
+        all.offsets.reserve(count + 1);
+        for (const Matches& part : parts) {
+            const size_t base = all.ids.size();
+            for (size_t offset : part.offsets) all.offsets.push_back(base + offset);
+            all.ids.insert(all.ids.end(), part.ids.begin(), part.ids.end());
+        }
+        all.offsets.push_back(all.ids.size());
+        return all;
+    }
+
+    template <typename Index>
+    std::vector<uint32_t> nearestBatch(const Index& index, const int32_t* x, const int32_t* y, size_t count, unsigned threads = 0)
+    {
+        std::vector<uint32_t> result(count);
+        threads = count ? std::max(1u, std::min<unsigned>(threads ? threads : std::thread::hardware_concurrency(), unsigned(count))) : 1;
+        parallelFor(count, threads, [&](unsigned, size_t begin, size_t end) {
+            for (size_t q = begin; q < end; q++) result[q] = index.nearest(x[q], y[q]);
+        });
+        return result;
+    }
+
+    template <typename Index>
+    Matches radiusBatch(const Index& index, const int32_t* x, const int32_t* y, size_t count, int32_t r, unsigned threads = 0)
+    {
+        return collect(count, threads, [&](size_t q, std::vector<uint32_t>& out) { index.radius(x[q], y[q], r, out); });
+    }
+
+    template <typename Index>
+    Matches boxBatch(const Index& index, const std::vector<Box>& boxes, unsigned threads = 0)
+    {
+        return collect(boxes.size(), threads, [&](size_t q, std::vector<uint32_t>& out) { index.box(boxes[q], out); });
+    }
+}
+
+#endif // VERTEX_INDEX_H
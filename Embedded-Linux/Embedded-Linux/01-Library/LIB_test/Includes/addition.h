@@ -1 +1,16 @@
-double add(float,float);
\ No newline at end of file
+#ifndef ADDITION_H
+#define ADDITION_H
+
+#include "mylib_function.h"
+
+#ifdef MYLIB_FUNCTION
+MYLIB_FUNCTION double add(float num1, float num2)
+{
+	double result = num1 + num2;
+	return result;
+}
+#else
+double add(float,float);
+#endif
+
+#endif
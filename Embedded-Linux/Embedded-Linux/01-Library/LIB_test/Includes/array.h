@@ -0,0 +1,48 @@
+#ifndef ARRAY_H
+#define ARRAY_H
+
+#include <stddef.h>
+
+
+
+/*
+ * Array versions of add, sub, multiplication, division and modulus.
+ *
+ * out[i] = op(x[i], y[i]) for i < n, with exactly the result the scalar
+ * function gives for the same pair (the operation is done in float and
+ * widened to double, modulus works on the values truncated to int).
+ * The arrays may have any alignment; out must not overlap x or y.
+ *
+ * The best implementation for the CPU (AVX-512, AVX2 or SSE2) is chosen once,
+ * when the program is loaded (GNU ifunc, glibc) or on the first call (other
+ * C libraries). libmylib.so and libmylib.a behave the same.
+ */
+void add_array(const float *x, const float *y, double *out, size_t n);
+void sub_array(const float *x, const float *y, double *out, size_t n);
+void multiplication_array(const float *x, const float *y, double *out, size_t n);
+void division_array(const float *x, const float *y, double *out, size_t n);
+void modulus_array(const float *x, const float *y, double *out, size_t n);
+
+
+/*
+ * Name        : array_isa
+ * Arguments   : void
+ * Return      : const char *
+ * Description : returns the instruction set the array functions use
+ *               ("avx512", "avx2" or "sse2").
+ */
+const char *array_isa(void);
+
+
+/*
+ * The individual implementations, for tests and benchmarks.
+ * Only call a variant when array_isa_supported() says the CPU has it.
+ */
+typedef void (*array_fn)(const float *x, const float *y, double *out, size_t n);
+
+enum array_op { ARRAY_ADD, ARRAY_SUB, ARRAY_MUL, ARRAY_DIV, ARRAY_MOD, ARRAY_OPS };
+
+int array_isa_supported(const char *isa);
+array_fn array_variant(enum array_op op, const char *isa);
+
+#endif
@@ -1,3 +1,8 @@
+#ifndef DIVISION_H
+#define DIVISION_H
+
+#include "mylib_function.h"
+
 /*
  * Author : Yusuf Sakr'
  *
@@ -15,6 +20,13 @@
  * Description : function returns the devided value of the first 
  *               argument by the second
  */
+#ifdef MYLIB_FUNCTION
+MYLIB_FUNCTION double division(float x, float y)
+{
+	return x / y;
+}
+#else
 double division (float x , float y);
+#endif
 
-
+#endif
@@ -1,3 +1,8 @@
+#ifndef MODULUS_H
+#define MODULUS_H
+
+#include "mylib_function.h"
+
 /*
  * Author : Yusuf Sakr
  *
@@ -15,6 +20,13 @@
  *               remainder of the devision process of the first 
  *               argument by the second one.
  */
+#ifdef MYLIB_FUNCTION
+MYLIB_FUNCTION double modulus(float x, float y)
+{
+	return (int)x % (int)y;
+}
+#else
 double modulus(float x, float y);
+#endif
 
-
+#endif
@@ -1,3 +1,8 @@
+#ifndef MULTIPLICATION_H
+#define MULTIPLICATION_H
+
+#include "mylib_function.h"
+
 /*
  * Author : yusuf Sakr
  *
@@ -15,5 +20,13 @@
  * Description : function receives two numbers and returns
  *               their multiplication value.
  */
+#ifdef MYLIB_FUNCTION
+MYLIB_FUNCTION double multiplication(float x, float y)
+{
+	return x * y;
+}
+#else
 double multiplication (float x, float y);
+#endif
 
+#endif
@@ -0,0 +1,20 @@
+#ifndef MYLIB_FUNCTION_H
+#define MYLIB_FUNCTION_H
+
+/*
+ * Each operation header holds the only copy of its function body.
+ *
+ *   MYLIB_DEFINE : set by src/X.c, which includes X.h to emit the
+ *                  library's external definition.
+ *   MYLIB_INLINE : set by an application (-DMYLIB_INLINE) to compile the
+ *                  same body static inline into itself, with no library.
+ *
+ * With neither, the headers only declare the functions.
+ */
+#if defined(MYLIB_DEFINE)
+#define MYLIB_FUNCTION
+#elif defined(MYLIB_INLINE)
+#define MYLIB_FUNCTION static inline
+#endif
+
+#endif
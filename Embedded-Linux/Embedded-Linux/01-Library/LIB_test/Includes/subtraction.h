@@ -1 +1,16 @@
-double sub(float ,float );
\ No newline at end of file
+#ifndef SUBTRACTION_H
+#define SUBTRACTION_H
+
+#include "mylib_function.h"
+
+#ifdef MYLIB_FUNCTION
+MYLIB_FUNCTION double sub(float num1, float num2)
+{
+	double result = num1 - num2;
+	return result;
+}
+#else
+double sub(float ,float );
+#endif
+
+#endif
@@ -0,0 +1,135 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "addition.h"
+#include "subtraction.h"
+#include "modulus.h"
+#include "multiplication.h"
+#include "division.h"
+#include "array.h"
+
+/*
+ * Checks every array variant the CPU supports against the scalar library
+ * functions (results must be identical) and prints its throughput in
+ * elements per second, next to one scalar call per element and the
+ * dispatched *_array function.
+ *
+ * Usage: ./benchArray [elements] [passes]
+ */
+
+typedef double (*scalar_fn)(float, float);
+
+static const char *names[ARRAY_OPS] = { "add", "sub", "multiplication", "division", "modulus" };
+static const scalar_fn scalars[ARRAY_OPS] = { add, sub, multiplication, division, modulus };
+static const array_fn dispatched[ARRAY_OPS] = { add_array, sub_array, multiplication_array, division_array, modulus_array };
+static const char *isas[] = { "scalar", "sse2", "avx2", "avx512" };
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Elements per second over passes runs */
+static double measure(array_fn fn, const float *x, const float *y, double *out, size_t n, int passes)
+{
+	double start = now();
+	for (int p = 0; p < passes; p++)
+		fn(x, y, out, n);
+	return (double)n * passes / (now() - start);
+}
+
+static double measure_scalar(scalar_fn fn, const float *x, const float *y, double *out, size_t n, int passes)
+{
+	double start = now();
+	for (int p = 0; p < passes; p++)
+		for (size_t i = 0; i < n; i++)
+			out[i] = fn(x[i], y[i]);
+	return (double)n * passes / (now() - start);
+}
+
+/* Compares fn against the scalar function on every length up to 70 and on n */
+static int verify(enum array_op op, array_fn fn, const float *x, const float *y, double *out, double *expected, size_t n)
+{
+	for (size_t length = 0; length <= 70 && length <= n; length++) {
+		fn(x + 1, y + 1, out, length);
+		for (size_t i = 0; i < length; i++) {
+			if (out[i] != scalars[op](x[i + 1], y[i + 1]))
+				return 0;
+		}
+	}
+	fn(x, y, out, n);
+	for (size_t i = 0; i < n; i++) {
+		if (memcmp(&out[i], &expected[i], sizeof(double)) != 0) {
+			printf("  mismatch at %zu: %.17g %.17g (%g, %g)\n", i, out[i], expected[i], x[i], y[i]);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int main(int argc, char *argv[]) {
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4096;
+	int passes = argc > 2 ? atoi(argv[2]) : 20000;
+	int failures = 0;
+
+	float *x = malloc((n + 1) * sizeof(float));
+	float *y = malloc((n + 1) * sizeof(float));
+	double *out = malloc(n * sizeof(double));
+	double *expected = malloc(n * sizeof(double));
+	if (x == NULL || y == NULL || out == NULL || expected == NULL) {
+		printf("ERROR! out of memory\n");
+		return 1;
+	}
+
+	/* Mixed signs and fractions; y never truncates to 0 so modulus is defined */
+	unsigned seed = 12345;
+	for (size_t i = 0; i <= n; i++) {
+		seed = seed * 1103515245 + 12345;
+		x[i] = (float)((int)(seed >> 8) % 200000 - 100000) / 7.0f;
+		seed = seed * 1103515245 + 12345;
+		y[i] = (float)((int)(seed >> 8) % 2000 - 1000) / 3.0f;
+		if ((int)y[i] == 0)
+			y[i] = 1.5f;
+	}
+
+	printf("array_isa: %s, %zu elements x %d passes (Melem/s)\n", array_isa(), n, passes);
+	printf("%-15s %10s", "operation", "per call");
+	for (size_t k = 0; k < sizeof(isas) / sizeof(isas[0]); k++) {
+		if (array_isa_supported(isas[k]))
+			printf(" %10s", isas[k]);
+	}
+	printf(" %10s\n", "dispatched");
+
+	for (int op = 0; op < ARRAY_OPS; op++) {
+		for (size_t i = 0; i < n; i++)
+			expected[i] = scalars[op](x[i], y[i]);
+
+		printf("%-15s %10.0f", names[op], measure_scalar(scalars[op], x, y, out, n, passes) / 1e6);
+		for (size_t k = 0; k < sizeof(isas) / sizeof(isas[0]); k++) {
+			array_fn fn = array_variant(op, isas[k]);
+			if (fn == NULL)
+				continue;
+			if (!verify(op, fn, x, y, out, expected, n)) {
+				printf(" %10s", "WRONG");
+				failures++;
+				continue;
+			}
+			printf(" %10.0f", measure(fn, x, y, out, n, passes) / 1e6);
+		}
+		if (!verify(op, dispatched[op], x, y, out, expected, n)) {
+			printf(" %10s\n", "WRONG");
+			failures++;
+			continue;
+		}
+		printf(" %10.0f\n", measure(dispatched[op], x, y, out, n, passes) / 1e6);
+	}
+
+	free(x);
+	free(y);
+	free(out);
+	free(expected);
+	return failures != 0;
+}
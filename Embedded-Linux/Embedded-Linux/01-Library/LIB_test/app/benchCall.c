@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "addition.h"
+#include "subtraction.h"
+#include "modulus.h"
+#include "multiplication.h"
+#include "division.h"
+
+/*
+ * Cost of one libmylib call in a tight loop. The same source is built
+ * against libmylib.a (Run), libmylib.so through the PLT (dynamicApp), the
+ * LTO archive, and with -DMYLIB_INLINE (header definitions), and
+ * BENCH_VARIANT names the build in the output.
+ *
+ * Usage: ./benchCall [elements] [passes]
+ */
+
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT "unknown"
+#endif
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* out[i] = fn(x[i], y[i]) over the arrays, passes times; prints ns per call */
+#define BENCH(fn)                                                            \
+	do {                                                                     \
+		double start = now();                                                \
+		for (int p = 0; p < passes; p++) {                                   \
+			for (size_t i = 0; i < n; i++)                                   \
+				out[i] = fn(x[i], y[i]);                                     \
+			__asm__ volatile("" : : "r"(out) : "memory");                    \
+		}                                                                    \
+		double ns = (now() - start) * 1e9 / ((double)n * passes);            \
+		double sum = 0;                                                      \
+		for (size_t i = 0; i < n; i++)                                       \
+			sum += out[i];                                                   \
+		printf("%-10s %-15s %8.3f ns/call   (checksum %.6g)\n",              \
+			BENCH_VARIANT, #fn, ns, sum);                                    \
+	} while (0)
+
+int main(int argc, char *argv[]) {
+	size_t n = argc > 1 ? strtoul(argv[1], NULL, 10) : 4096;
+	int passes = argc > 2 ? atoi(argv[2]) : 20000;
+
+	float *x = malloc(n * sizeof(float));
+	float *y = malloc(n * sizeof(float));
+	double *out = malloc(n * sizeof(double));
+	if (x == NULL || y == NULL || out == NULL) {
+		printf("ERROR! out of memory\n");
+		return 1;
+	}
+	for (size_t i = 0; i < n; i++) {
+		x[i] = (float)(i % 1000) + 0.5f;
+		y[i] = (float)(i % 97) + 1.25f;
+	}
+
+	BENCH(add);
+	BENCH(sub);
+	BENCH(multiplication);
+	BENCH(division);
+	BENCH(modulus);
+
+	free(x);
+	free(y);
+	free(out);
+	return 0;
+}
@@ -12,7 +12,7 @@
 int main() {
     char operator;
     float num1, num2;
-    double result;
+    double result = 0;
 
     printf("Enter operator (+, -, *, /, %%):\n");
     scanf("%c", &operator);
@@ -0,0 +1,16 @@
+#include <stdio.h>
+#include <time.h>
+#include "addition.h"
+
+/*
+ * Smallest program that still needs libmylib: prints the CLOCK_MONOTONIC
+ * time at which main was entered, for startupTime to compare with the
+ * time it called exec.
+ */
+int main() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double result = add(1, 2);
+    printf("main %lld %.0f\n", (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec, result);
+    return 0;
+}
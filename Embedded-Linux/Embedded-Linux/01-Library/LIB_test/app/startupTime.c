@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <spawn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/*
+ * Launches each program many times and reports:
+ *   exec->main  time from just before posix_spawn until the program's main
+ *               (for programs that print "main <CLOCK_MONOTONIC ns>" first,
+ *               like startupProbe)
+ *   exec->exit  time until waitpid returns
+ * Then runs dynamic programs again with LD_DEBUG=statistics and averages
+ * what the dynamic linker reports (static programs print nothing there).
+ * stdin is /dev/null so interactive programs such as Run end right away.
+ *
+ * Usage: ./startupTime [-n launches] program...
+ */
+
+extern char **environ;
+
+static long long now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compare(const void *a, const void *b)
+{
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Spawns path once with stdout (and stderr if capture_stderr) on a pipe
+ * and reads up to size - 1 bytes of it into buffer. Returns 0 on success.
+ */
+static int launch(const char *path, char **envp, int capture_stderr, long long *start, long long *end, char *buffer, size_t size)
+{
+    int fds[2];
+    if (pipe(fds) < 0)
+        return -1;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+    posix_spawn_file_actions_adddup2(&actions, fds[1], 1);
+    if (capture_stderr)
+        posix_spawn_file_actions_adddup2(&actions, fds[1], 2);
+    else
+        posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+    posix_spawn_file_actions_addclose(&actions, fds[0]);
+    posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+    char *argv[] = { (char *)path, NULL };
+    pid_t pid;
+    *start = now_ns();
+    int error = posix_spawn(&pid, path, &actions, NULL, argv, envp);
+    posix_spawn_file_actions_destroy(&actions);
+    close(fds[1]);
+    if (error != 0) {
+        close(fds[0]);
+        return -1;
+    }
+
+    size_t used = 0;
+    ssize_t got;
+    while ((got = read(fds[0], buffer + used, size - 1 - used)) > 0) {
+        used += got;
+        if (used == size - 1) {
+            char discard[4096];
+            while (read(fds[0], discard, sizeof(discard)) > 0)
+                ;
+            break;
+        }
+    }
+    buffer[used] = '\0';
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    *end = now_ns();
+    return 0;
+}
+
+static void print_times(const char *label, long long *values, int count)
+{
+    qsort(values, count, sizeof(values[0]), compare);
+    double mean = 0;
+    for (int i = 0; i < count; i++)
+        mean += values[i];
+    mean /= count;
+    printf("  %-11s min %8.1f  p50 %8.1f  p90 %8.1f  p99 %8.1f  mean %8.1f us\n", label,
+        values[0] / 1e3, values[count / 2] / 1e3, values[count * 9 / 10] / 1e3, values[count * 99 / 100] / 1e3, mean / 1e3);
+}
+
+/*
+ * Lines look like "  12084:\t  number of relocations: 90"; the "final ..."
+ * counts are printed at exit and include symbols bound lazily.
+ */
+static const char *statistics[] = {
+    "total startup time in dynamic loader",
+    "time needed for relocation",
+    "number of relocations",
+    "number of relocations from cache",
+    "number of relative relocations",
+    "time needed to load objects",
+    "final number of relocations",
+    "final number of relocations from cache",
+};
+#define STATISTICS (sizeof(statistics) / sizeof(statistics[0]))
+
+/* Adds each statistic in one run's output to totals; returns 1 if any was found */
+static int parse_statistics(const char *output, double totals[STATISTICS])
+{
+    int found = 0;
+    char line[512];
+    while (*output) {
+        size_t length = strcspn(output, "\n");
+        size_t copy = length < sizeof(line) - 1 ? length : sizeof(line) - 1;
+        memcpy(line, output, copy);
+        line[copy] = '\0';
+        output += length + (output[length] == '\n');
+
+        const char *field = strchr(line, ':');
+        if (field == NULL)
+            continue;
+        field += strspn(field + 1, " \t") + 1;
+        for (size_t s = 0; s < STATISTICS; s++) {
+            size_t name_length = strlen(statistics[s]);
+            if (strncmp(field, statistics[s], name_length) != 0 || field[name_length] != ':')
+                continue;
+            totals[s] += strtod(field + name_length + 1, NULL);
+            found = 1;
+        }
+    }
+    return found;
+}
+
+int main(int argc, char *argv[]) {
+    int launches = 1000;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        launches = atoi(argv[2]);
+        first = 3;
+    }
+    if (first >= argc || launches < 1) {
+        printf("Usage: %s [-n launches] program...\n", argv[0]);
+        return 1;
+    }
+
+    long long *to_main = malloc(launches * sizeof(long long));
+    long long *to_exit = malloc(launches * sizeof(long long));
+    if (to_main == NULL || to_exit == NULL) {
+        printf("ERROR! out of memory\n");
+        return 1;
+    }
+
+    /* environ plus LD_DEBUG=statistics, for the second round */
+    int env_count = 0;
+    while (environ[env_count] != NULL)
+        env_count++;
+    char **debug_env = malloc((env_count + 2) * sizeof(char *));
+    if (debug_env == NULL) {
+        printf("ERROR! out of memory\n");
+        return 1;
+    }
+    memcpy(debug_env, environ, env_count * sizeof(char *));
+    debug_env[env_count] = "LD_DEBUG=statistics";
+    debug_env[env_count + 1] = NULL;
+
+    static char output[1 << 16];
+    for (int p = first; p < argc; p++) {
+        const char *path = argv[p];
+        struct stat st;
+        if (stat(path, &st) < 0) {
+            printf("%s: Error opening file!\n", path);
+            continue;
+        }
+
+        /* One untimed launch so the binary and its libraries are in the page cache */
+        long long start, end;
+        launch(path, environ, 0, &start, &end, output, sizeof(output));
+
+        int mains = 0, done = 0;
+        for (; done < launches; done++) {
+            if (launch(path, environ, 0, &start, &end, output, sizeof(output)) != 0)
+                break;
+            to_exit[done] = end - start;
+            long long entered;
+            if (sscanf(output, "main %lld", &entered) == 1)
+                to_main[mains++] = entered - start;
+        }
+
+        if (done == 0) {
+            printf("%s: ERROR! could not launch\n", path);
+            continue;
+        }
+        printf("%s (%lld bytes, %d launches)\n", path, (long long)st.st_size, done);
+        if (mains > 0)
+            print_times("exec->main", to_main, mains);
+        print_times("exec->exit", to_exit, done);
+
+        double totals[STATISTICS] = { 0 };
+        int runs = done < 100 ? done : 100;
+        int reported = 0;
+        for (int i = 0; i < runs; i++) {
+            if (launch(path, debug_env, 1, &start, &end, output, sizeof(output)) == 0)
+                reported += parse_statistics(output, totals);
+        }
+        if (reported > 0) {
+            printf("  LD_DEBUG=statistics, mean of %d runs:\n", reported);
+            for (size_t s = 0; s < STATISTICS; s++)
+                printf("    %-40s %10.0f\n", statistics[s], totals[s] / reported);
+        } else {
+            printf("  LD_DEBUG=statistics: nothing reported (static binary)\n");
+        }
+    }
+
+    free(to_main);
+    free(to_exit);
+    free(debug_env);
+    return 0;
+}
@@ -0,0 +1,263 @@
+/*
+ * Name        : add_array, sub_array, multiplication_array,
+ *               division_array, modulus_array
+ * Arguments   : const float *x, const float *y, double *out, size_t n
+ * Return      : void
+ * Description : out[i] = op(x[i], y[i]) for every i < n, same results as
+ *               the scalar functions.
+ *
+ * Every operation has a plain C version and, on x86-64, SSE2, AVX2 and
+ * AVX-512 versions compiled with target attributes, so the library itself
+ * is built without -m flags and still runs on any x86-64 CPU.
+ *
+ * With glibc the exported symbols are GNU ifuncs. The loader (or, in a
+ * static binary, the startup code via IRELATIVE relocations) calls the
+ * resolver once and binds the symbol straight to the best version, so a
+ * call costs the same as any other call into the library. Other C libraries,
+ * or a build with -DARRAY_NO_IFUNC, resolve a function pointer on the first
+ * call instead.
+ */
+#include <stddef.h>
+#include <string.h>
+#include "array.h"
+
+#if defined(__x86_64__)
+#define ARRAY_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GLIBC__) && defined(ARRAY_X86) && !defined(ARRAY_NO_IFUNC)
+#define ARRAY_IFUNC 1
+#endif
+
+
+/* Plain C: the operation in float, widened to double, like add() etc. */
+#define SCALAR_OP(name, expr)                                                \
+static void name##_scalar(const float *x, const float *y, double *out, size_t n) \
+{                                                                            \
+	for (size_t i = 0; i < n; i++) {                                         \
+		float a = x[i], b = y[i];                                            \
+		out[i] = (expr);                                                     \
+	}                                                                        \
+}
+
+SCALAR_OP(add, (float)(a + b))
+SCALAR_OP(sub, (float)(a - b))
+SCALAR_OP(mul, (float)(a * b))
+SCALAR_OP(div, (float)(a / b))
+SCALAR_OP(mod, (int)a % (int)b)
+
+
+#ifdef ARRAY_X86
+
+/*
+ * add, sub, multiplication, division: the float operation on a full vector,
+ * then both halves widened to double.
+ */
+#define SSE2_OP(name, op)                                                    \
+__attribute__((target("sse2")))                                              \
+static void name##_sse2(const float *x, const float *y, double *out, size_t n) \
+{                                                                            \
+	size_t i = 0;                                                            \
+	for (; i + 4 <= n; i += 4) {                                             \
+		__m128 r = op(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i));             \
+		_mm_storeu_pd(out + i, _mm_cvtps_pd(r));                             \
+		_mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(r, r)));       \
+	}                                                                        \
+	name##_scalar(x + i, y + i, out + i, n - i);                             \
+}
+
+#define AVX2_OP(name, op)                                                    \
+__attribute__((target("avx2")))                                              \
+static void name##_avx2(const float *x, const float *y, double *out, size_t n) \
+{                                                                            \
+	size_t i = 0;                                                            \
+	for (; i + 8 <= n; i += 8) {                                             \
+		__m256 r = op(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i));       \
+		_mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm256_castps256_ps128(r))); \
+		_mm256_storeu_pd(out + i + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(r, 1))); \
+	}                                                                        \
+	name##_scalar(x + i, y + i, out + i, n - i);                             \
+}
+
+#define AVX512_OP(name, op)                                                  \
+__attribute__((target("avx512f")))                                           \
+static void name##_avx512(const float *x, const float *y, double *out, size_t n) \
+{                                                                            \
+	size_t i = 0;                                                            \
+	for (; i + 16 <= n; i += 16) {                                           \
+		__m512 r = op(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i));       \
+		_mm512_storeu_pd(out + i, _mm512_cvtps_pd(_mm512_castps512_ps256(r))); \
+		_mm512_storeu_pd(out + i + 8, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(r), 1)))); \
+	}                                                                        \
+	name##_scalar(x + i, y + i, out + i, n - i);                             \
+}
+
+#define VECTOR_OP(name, sse2, avx2, avx512)                                  \
+	SSE2_OP(name, sse2)                                                      \
+	AVX2_OP(name, avx2)                                                      \
+	AVX512_OP(name, avx512)
+
+VECTOR_OP(add, _mm_add_ps, _mm256_add_ps, _mm512_add_ps)
+VECTOR_OP(sub, _mm_sub_ps, _mm256_sub_ps, _mm512_sub_ps)
+VECTOR_OP(mul, _mm_mul_ps, _mm256_mul_ps, _mm512_mul_ps)
+VECTOR_OP(div, _mm_div_ps, _mm256_div_ps, _mm512_div_ps)
+
+
+/*
+ * modulus: (int)x % (int)y without an integer divide. Both sides are
+ * truncated to int and held in doubles, q = trunc(a / b) and r = a - b * q.
+ * For 32-bit a and b the double quotient is never close enough to the next
+ * integer to round onto it, so q and r are exact. As with modulus(), y
+ * must not truncate to 0.
+ */
+__attribute__((target("sse2")))
+static void mod_sse2(const float *x, const float *y, double *out, size_t n)
+{
+	size_t i = 0;
+	for (; i + 2 <= n; i += 2) {
+		__m128 xs = _mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)(x + i)));
+		__m128 ys = _mm_castsi128_ps(_mm_loadl_epi64((const __m128i *)(y + i)));
+		__m128d a = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_cvtps_pd(xs)));
+		__m128d b = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_cvtps_pd(ys)));
+		__m128d q = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_div_pd(a, b)));
+		_mm_storeu_pd(out + i, _mm_sub_pd(a, _mm_mul_pd(b, q)));
+	}
+	mod_scalar(x + i, y + i, out + i, n - i);
+}
+
+__attribute__((target("avx2")))
+static void mod_avx2(const float *x, const float *y, double *out, size_t n)
+{
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m256d a = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(_mm256_cvtps_pd(_mm_loadu_ps(x + i))));
+		__m256d b = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(_mm256_cvtps_pd(_mm_loadu_ps(y + i))));
+		__m256d q = _mm256_cvtepi32_pd(_mm256_cvttpd_epi32(_mm256_div_pd(a, b)));
+		_mm256_storeu_pd(out + i, _mm256_sub_pd(a, _mm256_mul_pd(b, q)));
+	}
+	mod_scalar(x + i, y + i, out + i, n - i);
+}
+
+__attribute__((target("avx512f")))
+static void mod_avx512(const float *x, const float *y, double *out, size_t n)
+{
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m512d a = _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(_mm512_cvtps_pd(_mm256_loadu_ps(x + i))));
+		__m512d b = _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(_mm512_cvtps_pd(_mm256_loadu_ps(y + i))));
+		__m512d q = _mm512_cvtepi32_pd(_mm512_cvttpd_epi32(_mm512_div_pd(a, b)));
+		_mm512_storeu_pd(out + i, _mm512_sub_pd(a, _mm512_mul_pd(b, q)));
+	}
+	mod_scalar(x + i, y + i, out + i, n - i);
+}
+
+#endif /* ARRAY_X86 */
+
+
+/*
+ * Picks the widest version the CPU supports. Resolvers run while the loader
+ * is still relocating the library, so they return function addresses
+ * directly instead of reading a table that may not be relocated yet.
+ */
+#ifdef ARRAY_X86
+#define SELECT(name)                                                         \
+	__builtin_cpu_init();                                                    \
+	if (__builtin_cpu_supports("avx512f"))                                   \
+		return name##_avx512;                                                \
+	if (__builtin_cpu_supports("avx2"))                                      \
+		return name##_avx2;                                                  \
+	return name##_sse2;
+#else
+#define SELECT(name) return name##_scalar;
+#endif
+
+static array_fn select_add(void) { SELECT(add) }
+static array_fn select_sub(void) { SELECT(sub) }
+static array_fn select_mul(void) { SELECT(mul) }
+static array_fn select_div(void) { SELECT(div) }
+static array_fn select_mod(void) { SELECT(mod) }
+
+
+#ifdef ARRAY_IFUNC
+
+void add_array(const float *x, const float *y, double *out, size_t n) __attribute__((ifunc("select_add")));
+void sub_array(const float *x, const float *y, double *out, size_t n) __attribute__((ifunc("select_sub")));
+void multiplication_array(const float *x, const float *y, double *out, size_t n) __attribute__((ifunc("select_mul")));
+void division_array(const float *x, const float *y, double *out, size_t n) __attribute__((ifunc("select_div")));
+void modulus_array(const float *x, const float *y, double *out, size_t n) __attribute__((ifunc("select_mod")));
+
+#else
+
+/* Racing first calls all store the same pointer, so no lock is needed */
+#define DISPATCH(function, select)                                           \
+void function(const float *x, const float *y, double *out, size_t n)         \
+{                                                                            \
+	static array_fn chosen;                                                  \
+	array_fn fn = __atomic_load_n(&chosen, __ATOMIC_RELAXED);                \
+	if (!fn) {                                                               \
+		fn = select();                                                       \
+		__atomic_store_n(&chosen, fn, __ATOMIC_RELAXED);                     \
+	}                                                                        \
+	fn(x, y, out, n);                                                        \
+}
+
+DISPATCH(add_array, select_add)
+DISPATCH(sub_array, select_sub)
+DISPATCH(multiplication_array, select_mul)
+DISPATCH(division_array, select_div)
+DISPATCH(modulus_array, select_mod)
+
+#endif
+
+
+int array_isa_supported(const char *isa)
+{
+	if (strcmp(isa, "scalar") == 0)
+		return 1;
+#ifdef ARRAY_X86
+	__builtin_cpu_init();
+	if (strcmp(isa, "sse2") == 0)
+		return 1;
+	if (strcmp(isa, "avx2") == 0)
+		return __builtin_cpu_supports("avx2") != 0;
+	if (strcmp(isa, "avx512") == 0)
+		return __builtin_cpu_supports("avx512f") != 0;
+#endif
+	return 0;
+}
+
+const char *array_isa(void)
+{
+	if (array_isa_supported("avx512"))
+		return "avx512";
+	if (array_isa_supported("avx2"))
+		return "avx2";
+	if (array_isa_supported("sse2"))
+		return "sse2";
+	return "scalar";
+}
+
+array_fn array_variant(enum array_op op, const char *isa)
+{
+	static const array_fn scalar[ARRAY_OPS] = { add_scalar, sub_scalar, mul_scalar, div_scalar, mod_scalar };
+#ifdef ARRAY_X86
+	static const array_fn sse2[ARRAY_OPS] = { add_sse2, sub_sse2, mul_sse2, div_sse2, mod_sse2 };
+	static const array_fn avx2[ARRAY_OPS] = { add_avx2, sub_avx2, mul_avx2, div_avx2, mod_avx2 };
+	static const array_fn avx512[ARRAY_OPS] = { add_avx512, sub_avx512, mul_avx512, div_avx512, mod_avx512 };
+#endif
+
+	if ((unsigned)op >= ARRAY_OPS || !array_isa_supported(isa))
+		return NULL;
+	if (strcmp(isa, "scalar") == 0)
+		return scalar[op];
+#ifdef ARRAY_X86
+	if (strcmp(isa, "sse2") == 0)
+		return sse2[op];
+	if (strcmp(isa, "avx2") == 0)
+		return avx2[op];
+	if (strcmp(isa, "avx512") == 0)
+		return avx512[op];
+#endif
+	return NULL;
+}
@@ -1,11 +1,3 @@
-/*
- * Name        : division
- * Arguments   : double x, double y
- * Return      : double
- * Description : function returns the devided value of the first 
- *               argument by the second
- */
-double division (float x, float y) {
-	return x / y;
-}
-
+/* The body of this function is in division.h; this file emits the library symbol */
+#define MYLIB_DEFINE
+#include "division.h"
@@ -1,11 +1,3 @@
-/*
- * Name        : modulus
- * Arguments   : double x, double y
- * Return      : double
- * Description : Function recieves two numbers and returns the 
- *               remainder of deviding the first sent number by 
- *               the second one.
- */
-double modulus (float x, float y) {
-	return (int)x % (int)y;
-}
+/* The body of this function is in modulus.h; this file emits the library symbol */
+#define MYLIB_DEFINE
+#include "modulus.h"
@@ -1,14 +1,3 @@
-/*
- * Name        : multiplication
- * Arguments   : double x, double y
- * Return      : double
- * Describtion : Function Recieves two numbers and return their 
- *               Multiplicated Value.
- */
-double multiplication (float x, float y) {
-        return x * y;
-}
-
-
-
-
+/* The body of this function is in multiplication.h; this file emits the library symbol */
+#define MYLIB_DEFINE
+#include "multiplication.h"
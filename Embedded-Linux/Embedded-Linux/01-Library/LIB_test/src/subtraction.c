@@ -1,7 +1,3 @@
-double sub(float num1,float num2)
-{
-
- double result = num1 - num2;
- return result;
-
-}
\ No newline at end of file
+/* The body of this function is in subtraction.h; this file emits the library symbol */
+#define MYLIB_DEFINE
+#include "subtraction.h"